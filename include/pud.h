@@ -86,10 +86,24 @@ typedef enum
    PUD_DIMENSIONS_128_128 /**< 128x128 map */
 } Pud_Dimensions;
 
+/* Maximum number of areas repainted by pud_minimap_update() */
+#define PUD_MINIMAP_DAMAGE_MAX 8
+
 typedef enum
 {
-   PUD_PIXEL_FORMAT_RGBA,
-   PUD_PIXEL_FORMAT_ARGB,
+   PUD_FILTER_NEAREST, /**< Tiles are replicated or skipped */
+   PUD_FILTER_BOX /**< Tiles are averaged when downscaling */
+} Pud_Filter;
+
+/* Formats are given in memory order */
+typedef enum
+{
+   PUD_PIXEL_FORMAT_RGBA, /**< 4 bytes: R, G, B, A */
+   PUD_PIXEL_FORMAT_ARGB, /**< 4 bytes: B, G, R, A (0xAARRGGBB on little-endian) */
+   PUD_PIXEL_FORMAT_BGRA, /**< 4 bytes: B, G, R, A */
+   PUD_PIXEL_FORMAT_RGB24, /**< 3 bytes: R, G, B */
+   PUD_PIXEL_FORMAT_RGB565, /**< 2 bytes: native-endian 5-6-5 bits word */
+   PUD_PIXEL_FORMAT_INDEXED8, /**< 1 byte: index in pud_minimap_palette_get() */
 } Pud_Pixel_Format;
 
 /**
@@ -495,9 +509,34 @@ typedef enum
 {
    PUD_OPEN_MODE_R = (1 << 0),
    PUD_OPEN_MODE_W = (1 << 1),
-   PUD_OPEN_MODE_RW = (PUD_OPEN_MODE_R | PUD_OPEN_MODE_W)
+   PUD_OPEN_MODE_RW = (PUD_OPEN_MODE_R | PUD_OPEN_MODE_W),
+
+   /* Read-only view: when possible, maps and units are not copied but
+    * point directly in the mapped file. Requires PUD_OPEN_MODE_R and
+    * cannot be combined with PUD_OPEN_MODE_W. */
+   PUD_OPEN_MODE_VIEW = (1 << 2),
+
+   /* Only the small header sections are decoded when the file is opened.
+    * UDTA, ALOW, UGRD, MTXM, SQM, OILM, REGM and UNIT are decoded the
+    * first time they are needed, or with pud_section_load(). */
+   PUD_OPEN_MODE_LAZY = (1 << 3)
 } Pud_Open_Mode;
 
+typedef enum
+{
+   PUD_MEMORY_BORROW = 0, /* The buffer must outlive the Pud */
+   PUD_MEMORY_OWN    = 1  /* The Pud takes the buffer and free()s it */
+} Pud_Memory_Ownership;
+
+typedef enum
+{
+   PUD_SAVE_ATOMIC  = (1 << 0), /* Write a sibling file, then rename() it */
+   PUD_SAVE_NO_SYNC = (1 << 1), /* Skip fsync(): faster, but not crash-safe */
+   PUD_SAVE_PATCH   = (1 << 2)  /* Only overwrite the dirty sections in place
+                                   when saving to the file that was opened.
+                                   Ignored with PUD_SAVE_ATOMIC */
+} Pud_Save_Flags;
+
 typedef enum
 {
    PUD_ERA_FOREST       = 0,
@@ -635,10 +674,32 @@ typedef enum
 /* Bits 20 to 31 are unused */
 
 typedef struct _Pud Pud;
+typedef struct _Pud_Minimap Pud_Minimap;
+typedef struct _Pud_Units_Index Pud_Units_Index;
 typedef struct _Pud_Unit_Data Pud_Unit_Data;
 typedef struct _Pud_Unit_Characteristics Pud_Unit_Characteristics;
 typedef struct _Pud_Upgrade_Characteristics Pud_Upgrade_Characteristics;
 
+/* An item of pud_open_many(): either a file, or a buffer (borrowed,
+ * it must outlive the Pud) when 'file' is NULL */
+typedef struct
+{
+   const char *file;
+   const void *buf;
+   size_t      len;
+} Pud_Batch_Item;
+
+typedef struct
+{
+   unsigned int  index; /* Index of the item in the batch */
+   Pud          *pud;   /* NULL on failure. Belongs to the callback */
+   int           error; /* errno-like reason of the failure, 0 on success */
+} Pud_Batch_Result;
+
+/* Called once per item, as soon as it has been parsed. Calls are made
+ * from the worker threads, but never concurrently. */
+typedef void (*Pud_Batch_Cb)(void *data, const Pud_Batch_Result *result);
+
 struct _Pud_Upgrade_Characteristics
 {
    uint8_t           time;
@@ -761,6 +822,16 @@ struct _Pud
    Pud_Unit_Data *units;
 
    unsigned int units_count;
+   unsigned int units_capacity; /* Allocated units (see pud_unit_add()) */
+
+   /* Single cache-aligned allocation holding the maps, the units and
+    * the filename of a parsed PUD. Its layout is computed for 'tiles'
+    * tiles, and the units advertised by the file. */
+   struct {
+      unsigned char *mem;
+      size_t         size;
+      unsigned int   tiles;
+   } arena;
 
    Pud_Unit_Characteristics unit_data[110]; /* [defaults] */
 
@@ -769,8 +840,33 @@ struct _Pud
    /* Bitfield: is section X present? */
    uint32_t     sections;
 
-   /* Cache */
-   uint8_t       current_section;
+   /* Sections directory: built in one pass when the file is opened.
+    * For each present section, 'offset' is the position of its data
+    * in 'mem_map' (the header is not included) and 'length' the size
+    * of its data, as advertised by the file. */
+   struct {
+      uint32_t offset;
+      uint32_t length;
+   } section_dir[20];
+
+   /* Bitfield: has section X been decoded? */
+   uint32_t     sections_parsed;
+
+   /* Bitfield: has section X been modified since the file was read? */
+   uint32_t     dirty;
+
+   /* Minimap kept up to date by the setters, if any */
+   Pud_Minimap *minimap;
+
+   /* Spatial index of the units, built by the first query */
+   Pud_Units_Index *units_index;
+
+   /* Identity of the mapped file, to detect it was replaced */
+   struct {
+      uint64_t dev;
+      uint64_t ino;
+      int64_t  mtime;
+   } file_id;
 
    Pud_Bool has_erax;
 
@@ -780,10 +876,28 @@ struct _Pud
    unsigned int  default_udta   : 1; /* [defaults] */
    unsigned int  default_ugrd   : 1; /* [defaults] */
    unsigned int  extension_pack : 1;
+   unsigned int  mem_map_mmap   : 1; /* mem_map comes from pud_mmap() */
+   unsigned int  mem_map_owned  : 1; /* mem_map must be free()d */
+   unsigned int  layout_stale   : 1; /* file rewritten: section_dir is not its layout */
 };
 
 typedef struct _Pud_Color Pud_Color;
 
+/* State of a random generator (xoshiro256**), see pud_random_seed().
+ * Each thread must use its own. */
+typedef struct
+{
+   uint64_t s[4];
+} Pud_Random;
+
+typedef struct
+{
+   unsigned int x;
+   unsigned int y;
+   unsigned int w;
+   unsigned int h;
+} Pud_Rect;
+
 struct _Pud_Color
 {
    unsigned char r;
@@ -821,12 +935,19 @@ void pud_shutdown(void);
 
 Pud *pud_open_new(const char *file, Pud_Open_Mode mode);
 Pud *pud_open(const char *file, Pud_Open_Mode mode);
+Pud *pud_open_memory(const void *buf, size_t len, Pud_Open_Mode mode, Pud_Memory_Ownership ownership);
+Pud_Bool pud_open_many(const Pud_Batch_Item *items, unsigned int count, Pud_Open_Mode mode, unsigned int workers, Pud_Batch_Cb cb, void *data);
 void pud_close(Pud *pud);
 Pud_Bool pud_reopen(Pud *pud, const char *file, Pud_Open_Mode mode);
 Pud_Bool pud_parse(Pud *pud);
 void pud_verbose_set(Pud *pud, int lvl);
 Pud_Bool pud_section_is_optional(Pud_Section sec);
 uint32_t pud_go_to_section(Pud *pud, Pud_Section sec);
+Pud_Bool pud_section_present_is(const Pud *pud, Pud_Section sec);
+uint32_t pud_section_length_get(const Pud *pud, Pud_Section sec);
+Pud_Bool pud_section_load(Pud *pud, Pud_Section sec);
+void pud_section_dirty_set(Pud *pud, Pud_Section sec);
+Pud_Bool pud_section_dirty_is(const Pud *pud, Pud_Section sec);
 void pud_print(Pud *pud, FILE *stream);
 void pud_dimensions_to_size(Pud_Dimensions dim, unsigned int *x_ret, unsigned int *y_ret);
 Pud_Owner pud_owner_convert(uint8_t code);
@@ -835,10 +956,20 @@ void pud_version_set(Pud *pud, uint16_t version);
 void pud_description_set(Pud *pud, const char descr[32]);
 const char *pud_description_get(const Pud *pud);
 void pud_tag_set(Pud *pud, uint32_t tag);
+Pud_Bool pud_starting_resources_set(Pud *pud, Pud_Player player, uint16_t gold, uint16_t lumber, uint16_t oil);
 Pud_Error pud_check(Pud *pud, Pud_Error_Description *err);
 Pud_Bool pud_defaults_set(Pud *pud);
 Pud_Bool pud_write(const Pud *pud, const char *file);
+Pud_Bool pud_save(Pud *pud, const char *file, Pud_Save_Flags flags);
+unsigned char *pud_write_memory(const Pud *pud, size_t *size_ret);
 int pud_unit_add(Pud *pud, uint16_t x, uint16_t y, Pud_Player owner, Pud_Unit type, uint16_t alter);
+int pud_units_add_bulk(Pud *pud, const Pud_Unit_Data *units, unsigned int count);
+Pud_Bool pud_units_index_build(Pud *pud);
+void pud_units_index_free(Pud *pud);
+unsigned int pud_units_in_rect(Pud *pud, const Pud_Rect *rect, unsigned int *units, unsigned int max);
+int pud_unit_at(Pud *pud, unsigned int x, unsigned int y);
+const uint8_t *pud_units_occupancy_get(Pud *pud, unsigned int *overlaps);
+Pud_Bool pud_units_area_free_is(Pud *pud, const Pud_Rect *rect);
 void pud_era_set(Pud *pud, Pud_Era era);
 void pud_dimensions_set(Pud *pud, Pud_Dimensions dims);
 void pud_tag_generate(Pud *pud);
@@ -847,8 +978,18 @@ void *pud_mmap(const char *file, size_t *size_ret);
 void pud_munmap(void *map, size_t size);
 
 unsigned char *pud_minimap_bitmap_generate(Pud *pud, unsigned int *size_ret, Pud_Pixel_Format pfmt);
+unsigned char *pud_minimap_render_scaled(Pud *pud, unsigned int out_w, unsigned int out_h, Pud_Filter filter, Pud_Pixel_Format pfmt, unsigned int *size_ret);
+Pud_Minimap *pud_minimap_new(Pud *pud, Pud_Pixel_Format pfmt);
+void pud_minimap_free(Pud_Minimap *mm);
+const unsigned char *pud_minimap_pixels_get(const Pud_Minimap *mm, unsigned int *w, unsigned int *h, size_t *stride);
+void pud_minimap_damage(Pud_Minimap *mm, const Pud_Rect *rect);
+unsigned int pud_minimap_update(Pud_Minimap *mm, Pud_Rect rects[PUD_MINIMAP_DAMAGE_MAX]);
+Pud_Bool pud_minimap_render(Pud *pud, Pud_Pixel_Format pfmt, unsigned char *dst, unsigned int dst_w, unsigned int dst_h, size_t stride, int x, int y);
+unsigned int pud_minimap_palette_get(const Pud *pud, Pud_Color palette[256]);
+unsigned int pud_pixel_format_bpp(Pud_Pixel_Format pfmt);
 
 Pud_Bool pud_minimap_to_ppm(Pud *pud, const char *file);
+Pud_Bool pud_minimap_to_ppm_scaled(Pud *pud, const char *file, unsigned int w, unsigned int h);
 
 const char *pud_section_at_index(int idx);
 
@@ -864,6 +1005,11 @@ uint16_t pud_tile_at(const Pud *pud, int x, int y);
 
 Pud_Bool pud_tile_set(Pud *pud, uint16_t x, uint16_t y, uint16_t tile);
 uint16_t pud_tile_get(const Pud *pud, unsigned int x, unsigned int y);
+Pud_Bool pud_tiles_fill_rect(Pud *pud, const Pud_Rect *rect, uint16_t tile);
+Pud_Bool pud_tiles_blit(Pud *pud, int x, int y, const uint16_t *src, unsigned int src_w, unsigned int src_h, size_t src_stride);
+Pud_Bool pud_tiles_copy(Pud *pud, int x, int y, Pud *src, const Pud_Rect *area);
+Pud_Bool pud_tiles_replace(Pud *pud, const Pud_Rect *rect, const uint16_t *lut, unsigned int lut_size);
+Pud_Bool pud_tiles_randomize(Pud *pud, const Pud_Rect *rect, uint64_t seed);
 Pud_Bool pud_unit_building_is(Pud_Unit unit);
 
 Pud_Bool pud_unit_start_location_is(Pud_Unit unit);
@@ -887,6 +1033,10 @@ Pud_Color pud_color_for_unit(Pud_Unit unit, Pud_Player player);
 Pud_Side pud_unit_side_get(Pud_Unit unit);
 
 uint8_t pud_random_get(uint16_t tile);
+void pud_random_seed(Pud_Random *rng, uint64_t seed);
+uint64_t pud_random_next(Pud_Random *rng);
+uint32_t pud_random_uniform(Pud_Random *rng, uint32_t bound);
+uint8_t pud_random_variant_get(uint16_t tile, Pud_Random *rng);
 Pud_Icon pud_unit_icon_get(Pud_Unit unit);
 Pud_Bool pud_unit_valid_is(Pud_Unit unit);
 Pud_Unit pud_unit_switch_side(Pud_Unit unit);
@@ -19,6 +19,15 @@
 #include "pud.h"
 
 Pud_Bool pud_section_exists(char sec[4]);
+Pud_Bool pud_sections_index(Pud *pud);
+Pud_Bool pud_sections_load(Pud *pud, uint32_t mask);
+
+#define PUD_CACHELINE_SIZE 64
+
+Pud_Bool pud_arena_setup(Pud *pud);
+void *pud_arena_slot_get(const Pud *pud, Pud_Section sec);
+void pud_array_free(Pud *pud, void *ptr);
+void *pud_array_realloc(Pud *pud, void *ptr, size_t old_size, size_t size);
 
 static inline Pud_Bool
 pud_mem_map_ok(Pud *pud)
@@ -26,9 +35,115 @@ pud_mem_map_ok(Pud *pud)
    return (pud->ptr < pud->mem_map + pud->mem_map_size);
 }
 
+/* Are there at least 'size' bytes left to be read from the current
+ * position in the memory map? */
+static inline Pud_Bool
+pud_mem_map_range_ok(const Pud *pud,
+                     size_t     size)
+{
+   return ((pud->ptr <= pud->mem_map + pud->mem_map_size) &&
+           ((size_t)(pud->mem_map + pud->mem_map_size - pud->ptr) >= size));
+}
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+# define PUD_BIG_ENDIAN 1
+#else
+# define PUD_BIG_ENDIAN 0
+#endif
+
+/* Does 'ptr' point in the memory map? If so, it has been borrowed by a
+ * view and must not be freed. */
+static inline Pud_Bool
+pud_borrowed_is(const Pud  *pud,
+                const void *ptr)
+{
+   const unsigned char *const p = ptr;
+
+   return ((p != NULL) && (pud->mem_map != NULL) &&
+           (p >= pud->mem_map) && (p < pud->mem_map + pud->mem_map_size));
+}
+
+/* Does 'ptr' point in the arena? If so, it must not be freed on its own */
+static inline Pud_Bool
+pud_arena_is(const Pud  *pud,
+             const void *ptr)
+{
+   const unsigned char *const p = ptr;
+
+   return ((p != NULL) && (pud->arena.mem != NULL) &&
+           (p >= pud->arena.mem) && (p < pud->arena.mem + pud->arena.size));
+}
+
+/* Can the data at the current position be used in place instead of
+ * being copied? */
+static inline Pud_Bool
+pud_view_borrowable_is(const Pud *pud,
+                       size_t     align)
+{
+   return ((pud->open_mode & PUD_OPEN_MODE_VIEW) && (!PUD_BIG_ENDIAN) &&
+           (((uintptr_t)pud->ptr & (align - 1)) == 0));
+}
+
+/* PUD files are little endian. On little endian hosts, this is a plain
+ * memcpy(). Otherwise, bytes are swapped in a loop simple enough to be
+ * vectorized by the compiler. */
+static inline void
+pud_le16_copy(uint16_t            *dst,
+              const unsigned char *src,
+              size_t               count)
+{
+#if PUD_BIG_ENDIAN
+   size_t i;
+
+   for (i = 0; i < count; i++)
+     dst[i] = (uint16_t)(src[2 * i] | (src[2 * i + 1] << 8));
+#else
+   memcpy(dst, src, count * sizeof(uint16_t));
+#endif
+}
+
+/* Counterpart of pud_le16_copy(), to write 16-bit values in a PUD */
+static inline void
+pud_le16_store(unsigned char  *dst,
+               const uint16_t *src,
+               size_t          count)
+{
+#if PUD_BIG_ENDIAN
+   size_t i;
+
+   for (i = 0; i < count; i++)
+     {
+        dst[2 * i] = src[i] & 0xff;
+        dst[2 * i + 1] = (src[i] >> 8) & 0xff;
+     }
+#else
+   memcpy(dst, src, count * sizeof(uint16_t));
+#endif
+}
+
 /* Visual hint when returning nothing */
 #define VOID
 
+#define PUD_SECTION_BIT(sec) (1u << (PUD_SECTION_ ## sec))
+
+#define PUD_SECTIONS_ALL 0x000fffffu
+
+/* Sections decoded on demand with PUD_OPEN_MODE_LAZY */
+#define PUD_SECTIONS_LAZY \
+   (PUD_SECTION_BIT(UDTA) | PUD_SECTION_BIT(ALOW) | PUD_SECTION_BIT(UGRD) | \
+    PUD_SECTION_BIT(MTXM) | PUD_SECTION_BIT(SQM)  | PUD_SECTION_BIT(OILM) | \
+    PUD_SECTION_BIT(REGM) | PUD_SECTION_BIT(UNIT))
+
+/* Decodes the sections of 'mask' that were not decoded yet. Decoding
+ * only fills data that is already part of the PUD, so accessors that
+ * take a const Pud may trigger it. */
+#define PUD_SECTIONS_LOAD(pud, mask, ...) \
+   do { \
+      if ((((pud)->sections_parsed & (mask)) != (mask)) && \
+          (!pud_sections_load((Pud *)(pud), (mask)))) \
+        return __VA_ARGS__; \
+   } while (0)
+
 #define PUD_VERBOSE(pud, lvl, msg, ...) \
    do { \
       if (pud->verbose >= lvl) { \
@@ -113,6 +228,68 @@ pud_mem_map_ok(Pud *pud)
 
 
 
+/* Tiles are below 0x0a00 */
+#define PUD_TILES_COUNT 0x0a00
+
+/* Colors of the tiles of an era. 'tiles' holds PUD_TILES_COUNT indexes
+ * in 'palette'. Index 0 is for tiles that do not exist. */
+typedef struct
+{
+   const Pud_Color *palette;
+   const uint8_t   *tiles;
+   unsigned int     count;
+} Pud_Tile_Colors;
+
+/* Size of the index tables: padded for 32-bits loads of the last entries */
+#define PUD_TILES_TABLE_SIZE (PUD_TILES_COUNT + 3)
+
+typedef unsigned int (*Pud_Tiles_Kernel)(unsigned char *out, const uint16_t *tiles, unsigned int count, const uint8_t *index, const uint32_t *pixels);
+
+/* Branch-free: out-of-range tiles are mapped to tile 0, which does not exist */
+#define PUD_TILE_COLOR_INDEX(tc, tile) \
+   ((tc)->tiles[((unsigned int)(tile) < PUD_TILES_COUNT) ? (tile) : 0])
+
+struct _Pud_Minimap
+{
+   Pud              *pud; /* NULL once the PUD is closed */
+   unsigned char    *pixels;
+   unsigned int      w;
+   unsigned int      h;
+   size_t            stride;
+   Pud_Pixel_Format  pfmt;
+
+   /* Areas to repaint. They never overlap. */
+   Pud_Rect          damages[PUD_MINIMAP_DAMAGE_MAX];
+   unsigned int      damages_count;
+};
+
+/* Units are bucketed by the 8x8 cell of their origin */
+#define PUD_UNITS_CELL_SHIFT 3
+
+struct _Pud_Units_Index
+{
+   int          *heads;     /* First unit of each cell, -1 if none */
+   int          *next;      /* Next unit of the same cell, -1 if none */
+   uint8_t      *occupancy; /* 1 bit per tile covered by a unit */
+   unsigned int  next_size;
+   unsigned int  count;     /* Indexed units */
+   unsigned int  cells_w;
+   unsigned int  cells_h;
+   unsigned int  map_w;
+   unsigned int  map_h;
+   unsigned int  max_w;     /* Largest footprint: how far queries look back */
+   unsigned int  max_h;
+   unsigned int  overlaps;  /* Tiles covered more than once */
+   Pud_Bool      stale;     /* Rebuilt by the next query */
+};
+
+/* Reports a change of the map to its minimap */
+#define PUD_MINIMAP_DAMAGE(pud_, x_, y_, w_, h_) \
+   do { \
+      if ((pud_)->minimap) \
+        pud_minimap_damage_add((pud_)->minimap, x_, y_, w_, h_); \
+   } while (0)
+
 //============================================================================//
 //                                 Private API                                //
 //============================================================================//
@@ -124,6 +301,15 @@ const char *mode2str(Pud_Open_Mode mode);
 
 Pud_Bool pud_mem_map_ok(Pud *pud);
 
+const Pud_Tile_Colors *pud_tile_colors_get(Pud_Era era);
+void pud_pixels_pack(uint32_t *pixels, const Pud_Color *colors, unsigned int count, Pud_Pixel_Format pfmt);
+Pud_Tiles_Kernel pud_tiles_kernel_get(unsigned int bpp);
+uint16_t pud_tile_variants_get(uint16_t tile);
+Pud_Bool pud_minimap_render_area(Pud *pud, Pud_Pixel_Format pfmt, unsigned char *dst, size_t stride, int x, int y, const Pud_Rect *area);
+void pud_minimap_damage_add(Pud_Minimap *mm, unsigned int x, unsigned int y, unsigned int w, unsigned int h);
+void pud_units_index_add(Pud *pud, unsigned int unit);
+void pud_units_index_invalidate(Pud *pud);
+
 
 Pud_Bool pud_parse_type(Pud *pud);
 Pud_Bool pud_parse_ver(Pud *pud);
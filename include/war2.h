@@ -11,12 +11,15 @@
 extern "C" {
 #endif
 
+#include <pthread.h>
+
 #include "pud.h"
 
 Pud_Bool war2_init(void);
 void war2_shutdown(void);
 
 typedef struct _War2_Data War2_Data;
+typedef struct _War2_Entry War2_Entry;
 typedef struct _War2_Tileset_Descriptor War2_Tileset_Descriptor;
 typedef struct _War2_Sprites_Descriptor War2_Sprites_Descriptor;
 typedef struct _War2_Color War2_Color;
@@ -29,6 +32,14 @@ typedef enum
    WAR2_SPRITES_SYSTEM    = 0x103
 } War2_Sprites;
 
+/*
+ * Once war2_open() has returned, the archive can be shared by several
+ * threads: the mapping is never modified and extractions do not use
+ * 'ptr' (which is only the cursor of war2_open()). Entries, palettes,
+ * tilesets and sprites can be extracted or decoded concurrently, the
+ * cache having its own lock. Changing the verbosity or the cache budget,
+ * and war2_close(), must not happen while other threads use it.
+ */
 struct _War2_Data
 {
    unsigned char *mem_map;
@@ -42,8 +53,50 @@ struct _War2_Data
    unsigned char **entries;
 
    unsigned int verbose;
+
+   /* Cache of decompressed entries (see war2_cache_budget_set()).
+    * 'cache' is indexed by entry, the LRU list starts with the most
+    * recently used entry. */
+   War2_Entry      **cache;
+   War2_Entry       *lru_first;
+   War2_Entry       *lru_last;
+   size_t            cache_size;
+   size_t            cache_budget;
+   pthread_mutex_t   cache_lock;
+};
+
+/* A decompressed entry, shared through war2_entry_get() */
+struct _War2_Entry
+{
+   const unsigned char *data;
+   size_t               size;
+   unsigned int         id;
+
+   /* Private */
+   War2_Data    *w2; /* NULL when not in the cache */
+   War2_Entry   *prev;
+   War2_Entry   *next;
+   unsigned int  refs;
 };
 
+/* Budget of the cache of a War2_Data, unless changed */
+#define WAR2_CACHE_BUDGET_DEFAULT (4 * 1024 * 1024)
+
+/* Memory held by war2_entries_extract_all() */
+#define WAR2_EXTRACT_MEM_DEFAULT (32 * 1024 * 1024)
+
+typedef struct
+{
+   unsigned int   entry; /* Index of the entry in the archive */
+   unsigned char *data;  /* NULL on failure. Belongs to the callback */
+   size_t         size;
+} War2_Extract_Result;
+
+/* Called once per entry, as soon as it has been extracted (or in the
+ * order of the entries when requested). Calls are made from the worker
+ * threads, but never concurrently. */
+typedef void (*War2_Extract_Cb)(void *data, const War2_Extract_Result *result);
+
 struct _War2_Tileset_Descriptor
 {
    Pud_Era       era;
@@ -72,7 +125,18 @@ War2_Data *war2_open(const char *file, int verbose);
 void war2_close(War2_Data *w2);
 void war2_verbosity_set(War2_Data *w2, int level);
 
+/* Returns a buffer to free(). The cache is only used when it already
+ * holds the entry. */
 unsigned char *war2_entry_extract(War2_Data *w2, unsigned int entry, size_t *size_ret);
+/* Uncompressed entries are borrowed from the mapping (valid until
+ * war2_close()). Others are decompressed: when '*owned' is PUD_TRUE,
+ * the buffer must be released with free(). */
+const unsigned char *war2_entry_view(War2_Data *w2, unsigned int entry, size_t *size_ret, Pud_Bool *owned);
+War2_Entry *war2_entry_get(War2_Data *w2, unsigned int entry);
+void war2_entry_unref(War2_Entry *e);
+void war2_cache_budget_set(War2_Data *w2, size_t budget);
+Pud_Bool war2_entries_extract(War2_Data *w2, unsigned int first, unsigned int count, unsigned int workers, Pud_Bool ordered, size_t mem_max, War2_Extract_Cb cb, void *data);
+Pud_Bool war2_entries_extract_all(War2_Data *w2, unsigned int workers, Pud_Bool ordered, War2_Extract_Cb cb, void *data);
 unsigned char *war2_palette_extract(War2_Data *w2, unsigned int entry);
 
 War2_Tileset_Descriptor *war2_tileset_decode(War2_Data *w2, Pud_Era era, War2_Tileset_Decode_Func func);
@@ -99,6 +163,14 @@ Pud_Bool war2_png_write(const char          *file,
                         int                  h,
                         const unsigned char *data);
 
+/* 'data' holds one byte per pixel, an index in 'palette' */
+Pud_Bool war2_png_indexed_write(const char          *file,
+                                int                  w,
+                                int                  h,
+                                const unsigned char *data,
+                                const Pud_Color     *palette,
+                                unsigned int         count);
+
 Pud_Bool
 war2_jpeg_write(const char          *file,
                 int                  w,
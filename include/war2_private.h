@@ -85,6 +85,11 @@
 
 
 Pud_Bool war2_mem_map_ok(War2_Data *w2);
-void war2_palette_convert(unsigned char *ptr, Pud_Color palette[256]);
+void war2_palette_convert(const unsigned char *ptr, Pud_Color palette[256]);
+unsigned char *war2_entry_decode(War2_Data *w2, unsigned int entry, size_t *size_ret);
+War2_Entry *war2_palette_get(War2_Data *w2, unsigned int entry);
+War2_Entry *war2_cache_lookup(War2_Data *w2, unsigned int entry);
+void war2_cache_free(War2_Data *w2);
+Pud_Bool war2_lz_decode(const unsigned char *in, size_t in_size, unsigned char *out, size_t ulen);
 
 #endif /* ! _WAR2_PRIVATE_H_ */
@@ -0,0 +1,229 @@
+/*
+ * batch.c
+ * libpud
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "pud_private.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/*
+ * Each worker owns a range of items, which it consumes from the front.
+ * A worker that runs out of items steals the back half of the largest
+ * range left, so a few slow maps do not keep the other workers idle.
+ */
+
+typedef struct
+{
+   pthread_mutex_t lock;
+   unsigned int    next;
+   unsigned int    end;
+} Queue;
+
+typedef struct
+{
+   const Pud_Batch_Item *items;
+   Pud_Open_Mode         mode;
+   Pud_Batch_Cb          cb;
+   void                 *data;
+
+   Queue                *queues;
+   unsigned int          workers;
+   pthread_mutex_t       cb_lock;
+} Batch;
+
+typedef struct
+{
+   Batch        *batch;
+   unsigned int  id;
+   pthread_t     thread;
+} Worker;
+
+static void
+_item_process(Batch        *b,
+              unsigned int  idx)
+{
+   const Pud_Batch_Item *const item = &(b->items[idx]);
+   Pud_Batch_Result res;
+
+   errno = 0;
+   if (item->file)
+     res.pud = pud_open(item->file, b->mode);
+   else
+     res.pud = pud_open_memory(item->buf, item->len, b->mode, PUD_MEMORY_BORROW);
+
+   res.index = idx;
+   res.error = (res.pud) ? 0 : ((errno) ? errno : EINVAL);
+
+   /* Results are delivered one at a time */
+   pthread_mutex_lock(&(b->cb_lock));
+   b->cb(b->data, &res);
+   pthread_mutex_unlock(&(b->cb_lock));
+}
+
+static Pud_Bool
+_queue_pop(Queue        *q,
+           unsigned int *idx)
+{
+   Pud_Bool ret = PUD_FALSE;
+
+   pthread_mutex_lock(&(q->lock));
+   if (q->next < q->end)
+     {
+        *idx = q->next++;
+        ret = PUD_TRUE;
+     }
+   pthread_mutex_unlock(&(q->lock));
+
+   return ret;
+}
+
+static Pud_Bool
+_steal(Batch        *b,
+       unsigned int  thief)
+{
+   Queue *victim = NULL, *q;
+   unsigned int i, left, best = 0, mid, end;
+
+   /* The victim is checked again when it is robbed */
+   for (i = 0; i < b->workers; i++)
+     {
+        if (i == thief) continue;
+        q = &(b->queues[i]);
+        pthread_mutex_lock(&(q->lock));
+        left = q->end - q->next;
+        pthread_mutex_unlock(&(q->lock));
+        if (left > best)
+          {
+             best = left;
+             victim = q;
+          }
+     }
+   if (!victim) return PUD_FALSE;
+
+   pthread_mutex_lock(&(victim->lock));
+   left = victim->end - victim->next;
+   if (left == 0)
+     {
+        pthread_mutex_unlock(&(victim->lock));
+        return PUD_TRUE; /* Someone was faster. Look again */
+     }
+   end = victim->end;
+   mid = victim->next + left / 2;
+   victim->end = mid;
+   pthread_mutex_unlock(&(victim->lock));
+
+   q = &(b->queues[thief]);
+   pthread_mutex_lock(&(q->lock));
+   q->next = mid;
+   q->end = end;
+   pthread_mutex_unlock(&(q->lock));
+
+   return PUD_TRUE;
+}
+
+static void *
+_worker_run(void *data)
+{
+   Worker *const w = data;
+   Batch *const b = w->batch;
+   unsigned int idx;
+
+   for (;;)
+     {
+        if (_queue_pop(&(b->queues[w->id]), &idx))
+          _item_process(b, idx);
+        else if (!_steal(b, w->id))
+          break;
+     }
+
+   return NULL;
+}
+
+Pud_Bool
+pud_open_many(const Pud_Batch_Item *items,
+              unsigned int          count,
+              Pud_Open_Mode         mode,
+              unsigned int          workers,
+              Pud_Batch_Cb          cb,
+              void                 *data)
+{
+   Batch b;
+   Worker *w;
+   unsigned int i, started;
+   long cpus;
+   int err;
+
+   if ((!items) || (!cb)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   if (count == 0) return PUD_TRUE;
+
+   if (workers == 0)
+     {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (cpus > 0) ? (unsigned int)cpus : 1;
+     }
+   if (workers > count) workers = count;
+
+   b.items = items;
+   b.mode = mode;
+   b.cb = cb;
+   b.data = data;
+   b.workers = workers;
+
+   /* No need for threads */
+   if (workers == 1)
+     {
+        pthread_mutex_init(&(b.cb_lock), NULL);
+        for (i = 0; i < count; i++)
+          _item_process(&b, i);
+        pthread_mutex_destroy(&(b.cb_lock));
+        return PUD_TRUE;
+     }
+
+   b.queues = calloc(workers, sizeof(Queue));
+   w = calloc(workers, sizeof(Worker));
+   if ((!b.queues) || (!w))
+     {
+        free(b.queues);
+        free(w);
+        DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+     }
+
+   /* Split the items evenly between the workers */
+   pthread_mutex_init(&(b.cb_lock), NULL);
+   for (i = 0; i < workers; i++)
+     {
+        pthread_mutex_init(&(b.queues[i].lock), NULL);
+        b.queues[i].next = (unsigned int)(((uint64_t)count * i) / workers);
+        b.queues[i].end = (unsigned int)(((uint64_t)count * (i + 1)) / workers);
+        w[i].batch = &b;
+        w[i].id = i;
+     }
+
+   for (started = 0; started < workers; started++)
+     {
+        err = pthread_create(&(w[started].thread), NULL, _worker_run, &(w[started]));
+        if (err != 0)
+          {
+             ERR("Failed to create worker thread: %s", strerror(err));
+             break;
+          }
+     }
+
+   /* Workers that could not be started have their items stolen. If none
+    * started, the work is done here. */
+   if (started == 0)
+     _worker_run(&(w[0]));
+   for (i = 0; i < started; i++)
+     pthread_join(w[i].thread, NULL);
+
+   for (i = 0; i < workers; i++)
+     pthread_mutex_destroy(&(b.queues[i].lock));
+   pthread_mutex_destroy(&(b.cb_lock));
+   free(b.queues);
+   free(w);
+
+   return PUD_TRUE;
+}
@@ -55,6 +55,15 @@ pud_defaults_set(Pud *pud)
    _ugrd_defaults_set(pud);
    pud_alow_defaults_set(pud);
 
+   /* Overridden: they must not be decoded later */
+   pud->sections_parsed |= (PUD_SECTION_BIT(UDTA) | PUD_SECTION_BIT(UGRD) |
+                            PUD_SECTION_BIT(ALOW));
+   pud->dirty |= (PUD_SECTION_BIT(SGLD) | PUD_SECTION_BIT(SLBR) |
+                  PUD_SECTION_BIT(SOIL) | PUD_SECTION_BIT(AIPL) |
+                  PUD_SECTION_BIT(SIDE) | PUD_SECTION_BIT(OWNR) |
+                  PUD_SECTION_BIT(UDTA) | PUD_SECTION_BIT(UGRD) |
+                  PUD_SECTION_BIT(ALOW));
+
    /* Most of the fields are assumed valid */
    pud->init = 1;
 
@@ -547,6 +556,7 @@ pud_alow_defaults_set(Pud *pud)
    unsigned int i;
 
    pud->default_allow = 1;
+   pud->dirty |= PUD_SECTION_BIT(ALOW);
 
    /* Everything is allowed */
    memset(&pud->unit_alow, 0xff, sizeof(struct _alow));
@@ -6,6 +6,173 @@
  */
 
 #include "pud_private.h"
+#include <limits.h>
+
+/* The minimap palette holds the colors of the era, followed by these */
+typedef enum
+{
+   UNIT_COLOR_PLAYERS   = 0, /* 8 players */
+   UNIT_COLOR_NEUTRAL   = 8,
+   UNIT_COLOR_GOLD_MINE = 9,
+   UNIT_COLOR_OIL_PATCH = 10,
+   UNIT_COLORS          = 11
+} Unit_Color;
+
+static unsigned int
+_unit_color_index(unsigned int         base,
+                  const Pud_Unit_Data *u)
+{
+   if (u->type == PUD_UNIT_GOLD_MINE)
+     return base + UNIT_COLOR_GOLD_MINE;
+   if (u->type == PUD_UNIT_OIL_PATCH)
+     return base + UNIT_COLOR_OIL_PATCH;
+   if (u->owner <= PUD_PLAYER_YELLOW)
+     return base + UNIT_COLOR_PLAYERS + u->owner;
+   if (u->owner == PUD_PLAYER_NEUTRAL)
+     return base + UNIT_COLOR_NEUTRAL;
+
+   ERR("Invalid player %i", u->owner);
+   return 0; /* Unknown color */
+}
+
+unsigned int
+pud_minimap_palette_get(const Pud *pud,
+                        Pud_Color  palette[256])
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
+
+   const Pud_Tile_Colors *const tc = pud_tile_colors_get(pud->era);
+   Pud_Color *const units = palette + tc->count;
+   unsigned int i;
+
+   memcpy(palette, tc->palette, tc->count * sizeof(Pud_Color));
+   for (i = 0; i <= PUD_PLAYER_YELLOW; i++)
+     units[UNIT_COLOR_PLAYERS + i] = pud_color_for_player(i);
+   units[UNIT_COLOR_NEUTRAL] = pud_color_for_player(PUD_PLAYER_NEUTRAL);
+   units[UNIT_COLOR_GOLD_MINE] = pud_gold_mine_color_get();
+   units[UNIT_COLOR_OIL_PATCH] = pud_oil_patch_color_get();
+
+   return tc->count + UNIT_COLORS;
+}
+
+/* Draws the tiles and units of 'area' (in map coordinates), the map
+ * origin being at x,y in the destination */
+Pud_Bool
+pud_minimap_render_area(Pud              *pud,
+                        Pud_Pixel_Format  pfmt,
+                        unsigned char    *dst,
+                        size_t            stride,
+                        int               x,
+                        int               y,
+                        const Pud_Rect   *area)
+{
+   const Pud_Tile_Colors *const tc = pud_tile_colors_get(pud->era);
+   const unsigned int bpp = pud_pixel_format_bpp(pfmt);
+   const long x0 = area->x, y0 = area->y;
+   const long x1 = x0 + area->w, y1 = y0 + area->h;
+   const Pud_Unit_Data *u;
+   Pud_Tiles_Kernel kernel;
+   Pud_Color palette[256];
+   uint32_t pixels[256];
+   unsigned char *row;
+   unsigned int ids[256];
+   unsigned int i, n, c, count, unknown = 0;
+   long j, k, ux0, uy0, ux1, uy1;
+   Pud_Bool indexed = PUD_FALSE;
+
+   if (bpp == 0) DIE_RETURN(PUD_FALSE, "Invalid pixel format");
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM) | PUD_SECTION_BIT(UDTA) |
+                     PUD_SECTION_BIT(UNIT), PUD_FALSE);
+   if ((x0 >= x1) || (y0 >= y1)) return PUD_TRUE;
+
+   /* The palette is converted to the pixel format once, the tiles are
+    * then converted by the fastest kernel of the CPU */
+   count = pud_minimap_palette_get(pud, palette);
+   pud_pixels_pack(pixels, palette, count, pfmt);
+   kernel = pud_tiles_kernel_get(bpp);
+
+#define PIXEL_AT(x_, y_) \
+   (dst + (((y_) + y) * stride) + (((x_) + x) * bpp))
+
+   for (j = y0; j < y1; j++)
+     unknown += kernel(PIXEL_AT(x0, j), &(pud->tiles_map[j * pud->map_w + x0]),
+                       x1 - x0, tc->tiles, pixels);
+   if (unknown)
+     ERR("%u unhandled tiles for era %s", unknown, pud_era2str(pud->era));
+
+   /* The spatial index, if any, gives the units of the area. Otherwise,
+    * or if they are too many, all the units are checked. */
+   n = pud->units_count;
+   if ((pud->units_index) && (!pud->units_index->stale))
+     {
+        n = pud_units_in_rect(pud, area, ids, sizeof(ids) / sizeof(ids[0]));
+        if (n > sizeof(ids) / sizeof(ids[0])) n = pud->units_count;
+        else indexed = PUD_TRUE;
+     }
+
+   for (i = 0; i < n; i++)
+     {
+        u = &(pud->units[(indexed) ? ids[i] : i]);
+
+        /* Units are clipped by the area */
+        ux0 = (u->x > x0) ? u->x : x0;
+        uy0 = (u->y > y0) ? u->y : y0;
+        ux1 = u->x + pud->unit_data[u->type].size_w;
+        uy1 = u->y + pud->unit_data[u->type].size_h;
+        if (ux1 > x1) ux1 = x1;
+        if (uy1 > y1) uy1 = y1;
+        if ((ux0 >= ux1) || (uy0 >= uy1)) continue;
+
+        c = _unit_color_index(tc->count, u);
+        for (j = uy0; j < uy1; j++)
+          {
+             row = PIXEL_AT(ux0, j);
+             for (k = 0; k < ux1 - ux0; k++)
+               memcpy(row + (k * bpp), &(pixels[c]), bpp);
+          }
+     }
+
+#undef PIXEL_AT
+
+   return PUD_TRUE;
+}
+
+Pud_Bool
+pud_minimap_render(Pud              *pud,
+                   Pud_Pixel_Format  pfmt,
+                   unsigned char    *dst,
+                   unsigned int      dst_w,
+                   unsigned int      dst_h,
+                   size_t            stride,
+                   int               x,
+                   int               y)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+
+   const unsigned int bpp = pud_pixel_format_bpp(pfmt);
+   Pud_Rect area;
+   long x0, y0, x1, y1;
+
+   if ((!dst) || (bpp == 0)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   if (stride < (size_t)dst_w * bpp)
+     DIE_RETURN(PUD_FALSE, "Stride %zu is too small for %u pixels", stride, dst_w);
+
+   /* Visible part of the map, in map coordinates */
+   x0 = (x < 0) ? -(long)x : 0;
+   y0 = (y < 0) ? -(long)y : 0;
+   x1 = (long)dst_w - x;
+   y1 = (long)dst_h - y;
+   if (x1 > pud->map_w) x1 = pud->map_w;
+   if (y1 > pud->map_h) y1 = pud->map_h;
+   if ((x0 >= x1) || (y0 >= y1)) return PUD_TRUE;
+
+   area.x = x0;
+   area.y = y0;
+   area.w = x1 - x0;
+   area.h = y1 - y0;
+
+   return pud_minimap_render_area(pud, pfmt, dst, stride, x, y, &area);
+}
 
 unsigned char *
 pud_minimap_bitmap_generate(Pud              *pud,
@@ -14,60 +181,208 @@ pud_minimap_bitmap_generate(Pud              *pud,
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, NULL);
 
+   const unsigned int bpp = pud_pixel_format_bpp(pfmt);
    unsigned char *map;
-   Pud_Unit_Data *u;
-   Pud_Color c;
-   unsigned int i, j, k;
-   int idx;
    unsigned int size;
-   uint16_t w, h;
-   const Pud_Era era = pud->era;
-   const unsigned int delta[2][4] = {
-      [PUD_PIXEL_FORMAT_RGBA] = {
-         0, 1, 2, 3
-      },
-      [PUD_PIXEL_FORMAT_ARGB] = {
-         2, 1, 0, 3
-      }
-   };
-
-   size = pud->tiles * 4;
+
+   if (bpp == 0) DIE_RETURN(NULL, "Invalid pixel format");
+
+   size = pud->tiles * bpp;
    map = malloc(size * sizeof(unsigned char));
    if (!map) DIE_RETURN(NULL, "Failed to allocate memory");
 
-   for (i = 0, idx = 0; i < pud->tiles; i++, idx += 4)
+   if (!pud_minimap_render(pud, pfmt, map, pud->map_w, pud->map_h,
+                           pud->map_w * bpp, 0, 0))
      {
-        c = pud_tile_to_color(era, pud->tiles_map[i]);
-
-        map[idx + delta[pfmt][0]] = c.r;
-        map[idx + delta[pfmt][1]] = c.g;
-        map[idx + delta[pfmt][2]] = c.b;
-        map[idx + delta[pfmt][3]] = c.a;
+        free(map);
+        DIE_RETURN(NULL, "Failed to render the minimap");
      }
 
-   for (i = 0; i < pud->units_count; i++)
+   if (size_ret) *size_ret = size;
+
+   return map;
+}
+
+/* Nearest neighbour, sampling the center of the output pixels */
+static void
+_scale_nearest(unsigned char        *out,
+               unsigned int          out_w,
+               unsigned int          out_h,
+               unsigned int          bpp,
+               const unsigned char  *idx,
+               unsigned int          w,
+               unsigned int          h,
+               const uint32_t       *pixels,
+               unsigned int         *xs)
+{
+   const size_t out_stride = (size_t)out_w * bpp;
+   const unsigned char *src;
+   unsigned char *row;
+   unsigned int x, y, sy, prev = UINT_MAX;
+
+   for (x = 0; x < out_w; x++)
+     xs[x] = (unsigned int)(((2 * (uint64_t)x + 1) * w) / (2 * (uint64_t)out_w));
+
+   for (y = 0; y < out_h; y++)
      {
-        u = &(pud->units[i]);
-        c = pud_color_for_unit(u->type, u->owner);
+        row = out + (y * out_stride);
+        sy = (unsigned int)(((2 * (uint64_t)y + 1) * h) / (2 * (uint64_t)out_h));
+
+        /* Upscaling: rows are repeated */
+        if (sy == prev)
+          {
+             memcpy(row, row - out_stride, out_stride);
+             continue;
+          }
+        prev = sy;
+        src = idx + (sy * w);
 
-        w = pud->unit_data[u->type].size_w;
-        h = pud->unit_data[u->type].size_h;
+#define ROW(bpp_) \
+   for (x = 0; x < out_w; x++) \
+     memcpy(row + (x * (bpp_)), &(pixels[src[xs[x]]]), (bpp_))
 
-        for (j = 0; j < w; j++)
+        switch (bpp)
           {
-             for (k = 0; k < h; k++)
+           case 1:  ROW(1); break;
+           case 2:  ROW(2); break;
+           case 3:  ROW(3); break;
+           default: ROW(4); break;
+          }
+
+#undef ROW
+     }
+}
+
+/* Box filter: each output pixel is the average of the tiles it covers */
+static Pud_Bool
+_scale_box(unsigned char        *out,
+           unsigned int          out_w,
+           unsigned int          out_h,
+           Pud_Pixel_Format      pfmt,
+           const unsigned char  *idx,
+           unsigned int          w,
+           unsigned int          h,
+           const Pud_Color      *palette,
+           unsigned int         *xs)
+{
+   const unsigned int bpp = pud_pixel_format_bpp(pfmt);
+   uint32_t *sums, acc[4], px;
+   const unsigned char *src;
+   unsigned char *row;
+   unsigned int x, y, sx, sy, y0, y1, n, k;
+   Pud_Color c;
+
+   /* Channel sums of each column, over the rows of an output row */
+   sums = malloc(w * 4 * sizeof(uint32_t));
+   if (!sums) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+
+   for (x = 0; x <= out_w; x++)
+     xs[x] = (unsigned int)(((uint64_t)x * w) / out_w);
+
+   for (y = 0; y < out_h; y++)
+     {
+        y0 = (unsigned int)(((uint64_t)y * h) / out_h);
+        y1 = (unsigned int)(((uint64_t)(y + 1) * h) / out_h);
+        if (y1 == y0) y1 = y0 + 1;
+
+        memset(sums, 0, w * 4 * sizeof(uint32_t));
+        for (sy = y0; sy < y1; sy++)
+          {
+             src = idx + (sy * w);
+             for (sx = 0; sx < w; sx++)
                {
-                  idx = (((u->y + k)* pud->map_w) + (u->x + j)) * 4;
+                  c = palette[src[sx]];
+                  sums[sx * 4 + 0] += c.r;
+                  sums[sx * 4 + 1] += c.g;
+                  sums[sx * 4 + 2] += c.b;
+                  sums[sx * 4 + 3] += c.a;
+               }
+          }
 
-                  map[idx + delta[pfmt][0]] = c.r;
-                  map[idx + delta[pfmt][1]] = c.g;
-                  map[idx + delta[pfmt][2]] = c.b;
-                  map[idx + delta[pfmt][3]] = c.a;
+        row = out + ((size_t)y * out_w * bpp);
+        for (x = 0; x < out_w; x++)
+          {
+             sx = xs[x];
+             n = (xs[x + 1] > sx) ? xs[x + 1] - sx : 1;
+             memset(acc, 0, sizeof(acc));
+             for (k = 0; k < n; k++)
+               {
+                  acc[0] += sums[(sx + k) * 4 + 0];
+                  acc[1] += sums[(sx + k) * 4 + 1];
+                  acc[2] += sums[(sx + k) * 4 + 2];
+                  acc[3] += sums[(sx + k) * 4 + 3];
                }
+             n *= (y1 - y0);
+             c.r = (acc[0] + n / 2) / n;
+             c.g = (acc[1] + n / 2) / n;
+             c.b = (acc[2] + n / 2) / n;
+             c.a = (acc[3] + n / 2) / n;
+             pud_pixels_pack(&px, &c, 1, pfmt);
+             memcpy(row + (x * bpp), &px, bpp);
           }
      }
 
+   free(sums);
+   return PUD_TRUE;
+}
+
+unsigned char *
+pud_minimap_render_scaled(Pud              *pud,
+                          unsigned int      out_w,
+                          unsigned int      out_h,
+                          Pud_Filter        filter,
+                          Pud_Pixel_Format  pfmt,
+                          unsigned int     *size_ret)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, NULL);
+
+   const unsigned int bpp = pud_pixel_format_bpp(pfmt);
+   unsigned char *idx, *out = NULL;
+   unsigned int *xs = NULL;
+   Pud_Color palette[256];
+   uint32_t pixels[256];
+   unsigned int count, size;
+   Pud_Bool chk = PUD_TRUE;
+
+   if ((bpp == 0) || (out_w == 0) || (out_h == 0))
+     DIE_RETURN(NULL, "Invalid inputs");
+   if ((uint64_t)out_w * out_h * bpp > UINT_MAX)
+     DIE_RETURN(NULL, "Output of %ux%u is too large", out_w, out_h);
+
+   /* Tiles and units are first resolved to palette indexes (1 byte per
+    * tile). Colors are then fetched while scaling. */
+   idx = pud_minimap_bitmap_generate(pud, NULL, PUD_PIXEL_FORMAT_INDEXED8);
+   if (!idx) DIE_RETURN(NULL, "Failed to generate the minimap");
+   count = pud_minimap_palette_get(pud, palette);
+
+   size = out_w * out_h * bpp;
+   out = malloc(size);
+   xs = malloc((out_w + 1) * sizeof(unsigned int));
+   if ((!out) || (!xs)) DIE_GOTO(fail, "Failed to allocate memory");
+
+   /* Indexes cannot be averaged. Box filtering only matters when
+    * downscaling on at least one axis. */
+   if ((filter == PUD_FILTER_BOX) && (pfmt != PUD_PIXEL_FORMAT_INDEXED8) &&
+       ((out_w < pud->map_w) || (out_h < pud->map_h)))
+     chk = _scale_box(out, out_w, out_h, pfmt, idx, pud->map_w, pud->map_h,
+                      palette, xs);
+   else
+     {
+        pud_pixels_pack(pixels, palette, count, pfmt);
+        _scale_nearest(out, out_w, out_h, bpp, idx, pud->map_w, pud->map_h,
+                       pixels, xs);
+     }
+   if (!chk) goto fail;
+
+   free(xs);
+   free(idx);
    if (size_ret) *size_ret = size;
 
-   return map;
+   return out;
+
+fail:
+   free(xs);
+   free(out);
+   free(idx);
+   return NULL;
 }
@@ -0,0 +1,201 @@
+/*
+ * kernels.c
+ * libpud
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "pud_private.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define HAVE_X86_KERNELS 1
+# include <immintrin.h>
+#endif
+
+//============================================================================//
+//                               Pixel Packing                                //
+//============================================================================//
+
+/*
+ * Pixels are packed in uint32_t, whose first bytes in memory are the pixel
+ * (see pud_pixel_format_bpp()). One packer per pixel format: the channel
+ * order is fixed at compile time.
+ */
+#define PIXEL_PACK_DEFINE(fmt_, c0_, c1_, c2_, c3_) \
+   static inline uint32_t \
+   _pixel_pack_##fmt_(Pud_Color c) \
+   { \
+      const unsigned char px[4] = { c0_, c1_, c2_, c3_ }; \
+      uint32_t v; \
+      memcpy(&v, px, sizeof(v)); \
+      return v; \
+   }
+
+PIXEL_PACK_DEFINE(rgba, c.r, c.g, c.b, c.a)
+PIXEL_PACK_DEFINE(bgra, c.b, c.g, c.r, c.a)
+PIXEL_PACK_DEFINE(rgb24, c.r, c.g, c.b, 0)
+
+#undef PIXEL_PACK_DEFINE
+
+static inline uint32_t
+_pixel_pack_rgb565(Pud_Color c)
+{
+   const uint16_t px = (uint16_t)(((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3));
+   uint32_t v = 0;
+
+   memcpy(&v, &px, sizeof(px));
+   return v;
+}
+
+static inline uint32_t
+_pixel_pack_indexed8(unsigned int idx)
+{
+   const unsigned char px[4] = { (unsigned char)idx, 0, 0, 0 };
+   uint32_t v;
+
+   memcpy(&v, px, sizeof(v));
+   return v;
+}
+
+unsigned int
+pud_pixel_format_bpp(Pud_Pixel_Format pfmt)
+{
+   switch (pfmt)
+     {
+      case PUD_PIXEL_FORMAT_RGBA:
+      case PUD_PIXEL_FORMAT_ARGB:
+      case PUD_PIXEL_FORMAT_BGRA:
+         return 4;
+
+      case PUD_PIXEL_FORMAT_RGB24:    return 3;
+      case PUD_PIXEL_FORMAT_RGB565:   return 2;
+      case PUD_PIXEL_FORMAT_INDEXED8: return 1;
+     }
+
+   ERR("Invalid pixel format %i", pfmt);
+   return 0;
+}
+
+void
+pud_pixels_pack(uint32_t         *pixels,
+                const Pud_Color  *colors,
+                unsigned int      count,
+                Pud_Pixel_Format  pfmt)
+{
+   unsigned int i;
+
+#define PACK(fmt_) \
+   for (i = 0; i < count; i++) pixels[i] = _pixel_pack_##fmt_(colors[i])
+
+   switch (pfmt)
+     {
+      case PUD_PIXEL_FORMAT_RGBA:   PACK(rgba);   break;
+      case PUD_PIXEL_FORMAT_ARGB:
+      case PUD_PIXEL_FORMAT_BGRA:   PACK(bgra);   break;
+      case PUD_PIXEL_FORMAT_RGB24:  PACK(rgb24);  break;
+      case PUD_PIXEL_FORMAT_RGB565: PACK(rgb565); break;
+
+      /* The pixels are the indexes in the palette */
+      case PUD_PIXEL_FORMAT_INDEXED8:
+         for (i = 0; i < count; i++) pixels[i] = _pixel_pack_indexed8(i);
+         break;
+     }
+
+#undef PACK
+}
+
+
+//============================================================================//
+//                                Tile Kernels                                //
+//============================================================================//
+
+/*
+ * A tile kernel writes 'count' packed pixels to 'out', going through the
+ * palette indexes of 'index' (see Pud_Tile_Colors), then through the
+ * packed palette 'pixels'. It returns the number of unknown tiles.
+ * There is one scalar kernel per pixel size.
+ */
+
+#define TILES_SCALAR_DEFINE(bpp_) \
+   static unsigned int \
+   _tiles_scalar_##bpp_(unsigned char  *out, \
+                        const uint16_t *tiles, \
+                        unsigned int    count, \
+                        const uint8_t  *index, \
+                        const uint32_t *pixels) \
+   { \
+      unsigned int i, k, unknown = 0; \
+      \
+      for (i = 0; i < count; i++) \
+        { \
+           k = index[(tiles[i] < PUD_TILES_COUNT) ? tiles[i] : 0]; \
+           unknown += (k == 0); \
+           memcpy(out + (i * bpp_), &(pixels[k]), bpp_); \
+        } \
+      \
+      return unknown; \
+   }
+
+TILES_SCALAR_DEFINE(1)
+TILES_SCALAR_DEFINE(2)
+TILES_SCALAR_DEFINE(3)
+TILES_SCALAR_DEFINE(4)
+
+#undef TILES_SCALAR_DEFINE
+
+#ifdef HAVE_X86_KERNELS
+
+/* The index tables are padded (PUD_TILES_TABLE_SIZE) so the 32-bits
+ * gather of the last entry stays in bounds */
+__attribute__((target("avx2")))
+static unsigned int
+_tiles_avx2(unsigned char  *out,
+            const uint16_t *tiles,
+            unsigned int    count,
+            const uint8_t  *index,
+            const uint32_t *pixels)
+{
+   const __m256i limit = _mm256_set1_epi32(PUD_TILES_COUNT);
+   const __m256i low = _mm256_set1_epi32(0xff);
+   const __m256i zero = _mm256_setzero_si256();
+   unsigned int i = 0, unknown = 0;
+   __m256i t, idx;
+
+   for (; i + 8 <= count; i += 8)
+     {
+        t = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(tiles + i)));
+        t = _mm256_and_si256(t, _mm256_cmpgt_epi32(limit, t));
+
+        idx = _mm256_i32gather_epi32((const int *)index, t, 1);
+        idx = _mm256_and_si256(idx, low);
+        unknown += (unsigned int)__builtin_popcount(
+           _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(idx, zero))));
+
+        _mm256_storeu_si256((__m256i *)(out + (i * 4)),
+                            _mm256_i32gather_epi32((const int *)pixels, idx, 4));
+     }
+
+   return unknown + _tiles_scalar_4(out + (i * 4), tiles + i, count - i,
+                                    index, pixels);
+}
+
+#endif /* HAVE_X86_KERNELS */
+
+Pud_Tiles_Kernel
+pud_tiles_kernel_get(unsigned int bpp)
+{
+   switch (bpp)
+     {
+      case 1: return _tiles_scalar_1;
+      case 2: return _tiles_scalar_2;
+      case 3: return _tiles_scalar_3;
+      default: break;
+     }
+
+   /* Only 32-bits pixels have a vectorized kernel. Without gathers, the
+    * lookups cannot be vectorized: there is no point in an SSE2 kernel. */
+#ifdef HAVE_X86_KERNELS
+   if (__builtin_cpu_supports("avx2")) return _tiles_avx2;
+#endif
+   return _tiles_scalar_4;
+}
@@ -0,0 +1,214 @@
+/*
+ * minimap.c
+ * libpud
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "pud_private.h"
+
+static inline Pud_Bool
+_rects_touch_is(const Pud_Rect *a,
+                const Pud_Rect *b)
+{
+   /* Adjacent rectangles are merged as well */
+   return ((a->x <= b->x + b->w) && (b->x <= a->x + a->w) &&
+           (a->y <= b->y + b->h) && (b->y <= a->y + a->h));
+}
+
+static inline void
+_rects_union(Pud_Rect       *dst,
+             const Pud_Rect *a,
+             const Pud_Rect *b)
+{
+   const unsigned int ax1 = a->x + a->w, ay1 = a->y + a->h;
+   const unsigned int bx1 = b->x + b->w, by1 = b->y + b->h;
+   const unsigned int x1 = (ax1 > bx1) ? ax1 : bx1;
+   const unsigned int y1 = (ay1 > by1) ? ay1 : by1;
+
+   dst->x = (a->x < b->x) ? a->x : b->x;
+   dst->y = (a->y < b->y) ? a->y : b->y;
+   dst->w = x1 - dst->x;
+   dst->h = y1 - dst->y;
+}
+
+static Pud_Bool
+_pixels_alloc(Pud_Minimap *mm)
+{
+   Pud *const pud = mm->pud;
+   const unsigned int bpp = pud_pixel_format_bpp(mm->pfmt);
+   unsigned char *pixels;
+
+   pixels = malloc((size_t)pud->map_w * pud->map_h * bpp);
+   if (!pixels) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+
+   free(mm->pixels);
+   mm->pixels = pixels;
+   mm->w = pud->map_w;
+   mm->h = pud->map_h;
+   mm->stride = (size_t)mm->w * bpp;
+
+   return PUD_TRUE;
+}
+
+void
+pud_minimap_damage_add(Pud_Minimap  *mm,
+                       unsigned int  x,
+                       unsigned int  y,
+                       unsigned int  w,
+                       unsigned int  h)
+{
+   Pud_Rect r, u;
+   unsigned int i, best = 0;
+   uint64_t area, best_area = UINT64_MAX;
+
+   if (!mm->pud) return;
+
+   /* Clip to the map */
+   if ((x >= mm->pud->map_w) || (y >= mm->pud->map_h)) return;
+   if (w > mm->pud->map_w - x) w = mm->pud->map_w - x;
+   if (h > mm->pud->map_h - y) h = mm->pud->map_h - y;
+   if ((w == 0) || (h == 0)) return;
+
+   r.x = x;
+   r.y = y;
+   r.w = w;
+   r.h = h;
+
+   /* Absorb the damages touching the new one, until none is left */
+   i = 0;
+   while (i < mm->damages_count)
+     {
+        if (_rects_touch_is(&r, &(mm->damages[i])))
+          {
+             _rects_union(&r, &r, &(mm->damages[i]));
+             mm->damages[i] = mm->damages[--mm->damages_count];
+             i = 0;
+          }
+        else
+          i++;
+     }
+
+   if (mm->damages_count < PUD_MINIMAP_DAMAGE_MAX)
+     {
+        mm->damages[mm->damages_count++] = r;
+        return;
+     }
+
+   /* No room left: merge with the damage that grows the least */
+   for (i = 0; i < mm->damages_count; i++)
+     {
+        _rects_union(&u, &r, &(mm->damages[i]));
+        area = (uint64_t)u.w * u.h;
+        if (area < best_area)
+          {
+             best_area = area;
+             best = i;
+          }
+     }
+   _rects_union(&r, &r, &(mm->damages[best]));
+   mm->damages[best] = mm->damages[--mm->damages_count];
+
+   /* The union may now touch other damages */
+   pud_minimap_damage_add(mm, r.x, r.y, r.w, r.h);
+}
+
+Pud_Minimap *
+pud_minimap_new(Pud              *pud,
+                Pud_Pixel_Format  pfmt)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, NULL);
+
+   Pud_Minimap *mm;
+
+   if (pud->minimap) DIE_RETURN(NULL, "PUD already has a minimap");
+   if (pud_pixel_format_bpp(pfmt) == 0)
+     DIE_RETURN(NULL, "Invalid pixel format");
+
+   mm = calloc(1, sizeof(*mm));
+   if (!mm) DIE_RETURN(NULL, "Failed to allocate memory");
+   mm->pud = pud;
+   mm->pfmt = pfmt;
+   if (!_pixels_alloc(mm))
+     {
+        free(mm);
+        return NULL;
+     }
+
+   /* Repainted areas only look at their own units */
+   pud_units_index_build(pud);
+
+   /* Painted by the first update */
+   pud->minimap = mm;
+   pud_minimap_damage(mm, NULL);
+
+   return mm;
+}
+
+void
+pud_minimap_free(Pud_Minimap *mm)
+{
+   if (!mm) return;
+   if (mm->pud) mm->pud->minimap = NULL;
+   free(mm->pixels);
+   free(mm);
+}
+
+const unsigned char *
+pud_minimap_pixels_get(const Pud_Minimap *mm,
+                       unsigned int      *w,
+                       unsigned int      *h,
+                       size_t            *stride)
+{
+   if (!mm) DIE_RETURN(NULL, "Invalid minimap");
+
+   if (w) *w = mm->w;
+   if (h) *h = mm->h;
+   if (stride) *stride = mm->stride;
+
+   return mm->pixels;
+}
+
+void
+pud_minimap_damage(Pud_Minimap    *mm,
+                   const Pud_Rect *rect)
+{
+   if ((!mm) || (!mm->pud)) return;
+
+   if (rect)
+     pud_minimap_damage_add(mm, rect->x, rect->y, rect->w, rect->h);
+   else
+     pud_minimap_damage_add(mm, 0, 0, mm->pud->map_w, mm->pud->map_h);
+}
+
+unsigned int
+pud_minimap_update(Pud_Minimap *mm,
+                   Pud_Rect     rects[PUD_MINIMAP_DAMAGE_MAX])
+{
+   unsigned int i, count;
+
+   if (!mm) DIE_RETURN(0, "Invalid minimap");
+   if (!mm->pud) DIE_RETURN(0, "The PUD of the minimap has been closed");
+
+   /* The dimensions changed: everything is repainted */
+   if ((mm->w != mm->pud->map_w) || (mm->h != mm->pud->map_h))
+     {
+        if (!_pixels_alloc(mm)) return 0;
+        mm->damages_count = 0;
+        pud_minimap_damage(mm, NULL);
+     }
+
+   for (i = 0; i < mm->damages_count; i++)
+     {
+        if (!pud_minimap_render_area(mm->pud, mm->pfmt, mm->pixels, mm->stride,
+                                     0, 0, &(mm->damages[i])))
+          DIE_RETURN(0, "Failed to repaint the minimap");
+     }
+
+   count = mm->damages_count;
+   if (rects)
+     memcpy(rects, mm->damages, count * sizeof(Pud_Rect));
+   mm->damages_count = 0;
+
+   return count;
+}
@@ -11,7 +11,63 @@
  * Parsing of individual sections is here
  */
 
-#define HAS_SECTION(sec) pud->sections |= (1 << sec)
+/* Units can be read and borrowed as they are stored in the file */
+typedef char _pud_unit_data_size_check[(sizeof(Pud_Unit_Data) == 8) ? 1 : -1];
+
+/* Returns where the data of 'sec' at the current position must be
+ * decoded to. In view mode, this may be the memory map itself, in which
+ * case 'borrowed' is set and nothing has to be copied. Otherwise, this
+ * is the slot of the section in the arena, if any. */
+static void *
+_storage_get(Pud         *pud,
+             Pud_Section  sec,
+             void        *old,
+             size_t       size,
+             size_t       align,
+             Pud_Bool    *borrowed)
+{
+   void *slot;
+
+   if (pud_view_borrowable_is(pud, align))
+     {
+        pud_array_free(pud, old);
+        *borrowed = PUD_TRUE;
+        return pud->ptr;
+     }
+
+   *borrowed = PUD_FALSE;
+   slot = pud_arena_slot_get(pud, sec);
+   if (slot)
+     {
+        pud_array_free(pud, old);
+        return slot;
+     }
+
+   if (pud_borrowed_is(pud, old) || pud_arena_is(pud, old)) old = NULL;
+   return realloc(old, size);
+}
+
+static Pud_Bool
+_map_load(Pud          *pud,
+          Pud_Section   sec,
+          uint16_t    **map)
+{
+   const size_t size = pud->tiles * sizeof(uint16_t);
+   Pud_Bool borrowed;
+   uint16_t *ptr;
+
+   if (!pud_mem_map_range_ok(pud, size))
+     DIE_RETURN(PUD_FALSE, "Read outside of memory map!");
+
+   ptr = _storage_get(pud, sec, *map, size, sizeof(uint16_t), &borrowed);
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   *map = ptr;
+
+   if (!borrowed) pud_le16_copy(ptr, pud->ptr, pud->tiles);
+   pud->ptr += size;
+
+   return PUD_TRUE;
+}
 
 Pud_Bool
 pud_parse_type(Pud *pud)
@@ -28,7 +84,6 @@ pud_parse_type(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_TYPE);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section TYPE");
    PUD_VERBOSE(pud, 2, "At section TYPE (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_TYPE);
 
    /* Read 10bytes + 2 unused */
    READBUF(pud, buf, uint8_t, 12, FAIL(PUD_FALSE));
@@ -54,7 +109,6 @@ pud_parse_ver(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_VER);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section VER");
    PUD_VERBOSE(pud, 2, "At section VER (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_VER);
 
    w = READ16(pud, FAIL(PUD_FALSE));
 
@@ -90,7 +144,6 @@ pud_parse_desc(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_DESC);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section DESC");
    PUD_VERBOSE(pud, 2, "At section DESC (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_DESC);
 
    READBUF(pud, buf, char, 32, FAIL(PUD_FALSE));
    memcpy(pud->description, buf, 32 * sizeof(char));
@@ -109,7 +162,6 @@ pud_parse_ownr(Pud *pud)
    len = pud_go_to_section(pud, PUD_SECTION_OWNR);
    if (!len) DIE_RETURN(PUD_FALSE, "Failed to reach section OWNR");
    PUD_VERBOSE(pud, 2, "At section OWNR (size = %u)", len);
-   HAS_SECTION(PUD_SECTION_OWNR);
 
    READBUF(pud, buf, uint8_t, 8, FAIL(PUD_FALSE));
    memcpy(pud->owner.players, buf, 8 * sizeof(uint8_t));
@@ -134,7 +186,6 @@ pud_parse_side(Pud *pud)
    len = pud_go_to_section(pud, PUD_SECTION_SIDE);
    if (!len) DIE_RETURN(PUD_FALSE, "Failed to reach section SIDE");
    PUD_VERBOSE(pud, 2, "At section SIDE (size = %u)", len);
-   HAS_SECTION(PUD_SECTION_SIDE);
 
    READBUF(pud, buf, uint8_t, 8, FAIL(PUD_FALSE));
    memcpy(pud->side.players, buf, 8 * sizeof(uint8_t));
@@ -164,13 +215,11 @@ pud_parse_era(Pud *pud)
         chk = pud_go_to_section(pud, PUD_SECTION_ERA);
         if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section ERA");
         PUD_VERBOSE(pud, 2, "At section ERA (size = %u)", chk);
-        HAS_SECTION(PUD_SECTION_ERA);
      }
    else
      {
         pud->has_erax = PUD_TRUE;
         PUD_VERBOSE(pud, 2, "At section ERAX (size = %u)", chk);
-        HAS_SECTION(PUD_SECTION_ERAX);
      }
 
    w = READ16(pud, FAIL(PUD_FALSE));
@@ -209,12 +258,10 @@ pud_parse_dim(Pud *pud)
    uint32_t chk;
    uint16_t x, y;
    Pud_Dimensions dim;
-   Pud_Open_Mode mode;
 
    chk = pud_go_to_section(pud, PUD_SECTION_DIM);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section DIM");
    PUD_VERBOSE(pud, 2, "At section DIM (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_DIM);
 
    x = READ16(pud, FAIL(PUD_FALSE));
    y = READ16(pud, FAIL(PUD_FALSE));
@@ -230,12 +277,15 @@ pud_parse_dim(Pud *pud)
    else
      DIE_RETURN(PUD_FALSE, "Invalid dimensions %i x %i", x, y);
 
-   /* Override permissions because pud_dimensions_set() is
-    * damn convenient to use */
-   mode = pud->open_mode;
-   pud->open_mode = PUD_OPEN_MODE_W;
-   pud_dimensions_set(pud, dim);
-   pud->open_mode = mode;
+   pud->dims = dim;
+   pud->map_w = x;
+   pud->map_h = y;
+   pud->tiles = x * y;
+
+   /* Maps are borrowed by their own sections in view mode. Otherwise,
+    * they are all decoded in a single arena. */
+   if ((!(pud->open_mode & PUD_OPEN_MODE_VIEW)) && (!pud_arena_setup(pud)))
+     DIE_RETURN(PUD_FALSE, "Failed to allocate the arena");
 
    return PUD_TRUE;
 }
@@ -254,7 +304,6 @@ pud_parse_udta(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_UDTA);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UDTA");
    PUD_VERBOSE(pud, 2, "At section UDTA (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_UDTA);
 
    /* Use default data */
    READBUF(pud, wb, uint16_t, 1, FAIL(PUD_FALSE));
@@ -448,7 +497,6 @@ pud_parse_alow(Pud *pud)
         return PUD_TRUE;
      }
    PUD_VERBOSE(pud, 2, "At section ALOW (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_ALOW);
 
    for (i = 0; i < ptrs_count; i++)
      {
@@ -476,7 +524,6 @@ pud_parse_ugrd(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_UGRD);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UGRD");
    PUD_VERBOSE(pud, 2, "At section UGRD (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_UGRD);
 
    /* Use default data */
    READBUF(pud, wb, uint16_t, 1, FAIL(PUD_FALSE));
@@ -531,7 +578,6 @@ pud_parse_sgld(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_SGLD);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SGLD");
    PUD_VERBOSE(pud, 2, "At section SGLD (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_SGLD);
 
    READBUF(pud, buf, uint16_t, 16, FAIL(PUD_FALSE));
 
@@ -553,7 +599,6 @@ pud_parse_slbr(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_SLBR);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SLBR");
    PUD_VERBOSE(pud, 2, "At section SLBR (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_SLBR);
 
    READBUF(pud, buf, uint16_t, 16, FAIL(PUD_FALSE));
 
@@ -575,7 +620,6 @@ pud_parse_soil(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_SOIL);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SOIL");
    PUD_VERBOSE(pud, 2, "At section SOIL (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_SOIL);
 
    READBUF(pud, buf, uint16_t, 16, FAIL(PUD_FALSE));
 
@@ -597,7 +641,6 @@ pud_parse_aipl(Pud *pud)
    chk = pud_go_to_section(pud, PUD_SECTION_AIPL);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section AIPL");
    PUD_VERBOSE(pud, 2, "At section AIPL (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_AIPL);
 
    READBUF(pud, buf, uint8_t, 16, FAIL(PUD_FALSE));
 
@@ -614,25 +657,16 @@ pud_parse_mtxm(Pud *pud)
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
    chk = pud_go_to_section(pud, PUD_SECTION_MTXM);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section MTXM");
    PUD_VERBOSE(pud, 2, "At section MTXM (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_MTXM);
 
    /* Check for integrity */
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = READ16(pud, FAIL(0));
-        pud->tiles_map[i] = w;
-     }
-
-   return PUD_TRUE;
+   return _map_load(pud, PUD_SECTION_MTXM, &(pud->tiles_map));
 }
 
 Pud_Bool
@@ -641,25 +675,16 @@ pud_parse_sqm(Pud *pud)
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
    chk = pud_go_to_section(pud, PUD_SECTION_SQM);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section SQM ");
    PUD_VERBOSE(pud, 2, "At section SQM  (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_SQM);
 
    /* Check for integrity */
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = READ16(pud, FAIL(0));
-        pud->movement_map[i] = w;
-     }
-
-   return PUD_TRUE;
+   return _map_load(pud, PUD_SECTION_SQM, &(pud->movement_map));
 }
 
 Pud_Bool
@@ -668,20 +693,21 @@ pud_parse_oilm(Pud *pud)
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    uint32_t chk;
-   unsigned int i;
-   uint8_t b;
+   uint8_t *ptr;
+   Pud_Bool borrowed;
 
    chk = pud_go_to_section(pud, PUD_SECTION_OILM);
    if (!chk) PUD_VERBOSE(pud, 2, "Section OILM (obsolete) not present. Skipping...");
    else
      {
-        if (!pud->oil_map)
-          pud->oil_map = malloc(pud->tiles * sizeof(uint8_t));
-        for (i = 0; i < pud->tiles; i++)
-          {
-             b = READ8(pud, FAIL(0));
-             pud->oil_map[i] = b;
-          }
+        if (!pud_mem_map_range_ok(pud, pud->tiles))
+          DIE_RETURN(PUD_FALSE, "Read outside of memory map!");
+        ptr = _storage_get(pud, PUD_SECTION_OILM, pud->oil_map, pud->tiles, 1,
+                           &borrowed);
+        if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        pud->oil_map = ptr;
+        if (!borrowed) memcpy(ptr, pud->ptr, pud->tiles * sizeof(uint8_t));
+        pud->ptr += pud->tiles;
      }
 
    return PUD_TRUE;
@@ -693,25 +719,16 @@ pud_parse_regm(Pud *pud)
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    uint32_t chk;
-   uint16_t w;
-   unsigned int i;
 
    chk = pud_go_to_section(pud, PUD_SECTION_REGM);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section REGM");
    PUD_VERBOSE(pud, 2, "At section REGM (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_REGM);
 
    /* Check for integrity */
    if ((pud->tiles * sizeof(uint16_t)) != chk)
      DIE_RETURN(PUD_FALSE, "Mismatch between dims and tiles number");
 
-   for (i = 0; i < pud->tiles; i++)
-     {
-        w = READ16(pud, FAIL(0));
-        pud->action_map[i] = w;
-     }
-
-   return PUD_TRUE;
+   return _map_load(pud, PUD_SECTION_REGM, &(pud->action_map));
 }
 
 Pud_Bool
@@ -721,28 +738,57 @@ pud_parse_unit(Pud *pud)
 
    uint32_t chk;
    int units, size, i;
-   Pud_Unit_Data *u;
+   Pud_Unit_Data *u, *ptr;
+   const unsigned char *p;
+   Pud_Bool borrowed;
 
    chk = pud_go_to_section(pud, PUD_SECTION_UNIT);
    if (!chk) DIE_RETURN(PUD_FALSE, "Failed to reach section UNIT");
    PUD_VERBOSE(pud, 2, "At section UNIT (size = %u)", chk);
-   HAS_SECTION(PUD_SECTION_UNIT);
    units = chk / 8;
+   pud->starting_points = 0;
+
+   if (!pud_mem_map_range_ok(pud, units * 8))
+     DIE_RETURN(PUD_FALSE, "Read outside of memory map!");
 
    size = sizeof(Pud_Unit_Data) * units;
-   pud->units = realloc(pud->units, size);
-   if (!pud->units) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
-   memset(pud->units, 0, size);
+   if (size == 0)
+     {
+        pud_array_free(pud, pud->units);
+        pud->units = NULL;
+        pud->units_count = 0;
+        pud->units_capacity = 0;
+        return PUD_TRUE;
+     }
+
+   /* A unit is stored on 8 bytes, which is exactly the in-memory layout
+    * of Pud_Unit_Data on little endian hosts. */
+   ptr = _storage_get(pud, PUD_SECTION_UNIT, pud->units, size,
+                      sizeof(uint16_t), &borrowed);
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   pud->units = ptr;
    pud->units_count = units;
+   pud->units_capacity = units;
 
-   for (i = 0; i < units; ++i)
+   p = pud->ptr;
+   if (borrowed)
      {
-        pud->units[i].x     = READ16(pud, ECHAP(err));
-        pud->units[i].y     = READ16(pud, ECHAP(err));
-        pud->units[i].type  = READ8(pud, ECHAP(err));
-        pud->units[i].owner = READ8(pud, ECHAP(err));
-        pud->units[i].alter = READ16(pud, ECHAP(err));
+        /* Nothing to do */
      }
+   else if (!PUD_BIG_ENDIAN)
+     memcpy(pud->units, p, size);
+   else
+     {
+        for (i = 0; i < units; ++i, p += 8)
+          {
+             pud->units[i].x     = p[0] | (p[1] << 8);
+             pud->units[i].y     = p[2] | (p[3] << 8);
+             pud->units[i].type  = p[4];
+             pud->units[i].owner = p[5];
+             pud->units[i].alter = p[6] | (p[7] << 8);
+          }
+     }
+   pud->ptr += units * 8;
 
    for (i = 0; i < units; i++)
      {
@@ -761,9 +807,4 @@ pud_parse_unit(Pud *pud)
 
 
    return PUD_TRUE;
-
-err:
-   free(pud->units);
-   pud->units = NULL;
-   return PUD_FALSE;
 }
@@ -16,6 +16,7 @@ pud_print(Pud  *pud,
    unsigned int i, j;
 
    if (!stream) stream = stdout;
+   PUD_SECTIONS_LOAD(pud, PUD_SECTIONS_ALL, VOID);
 
    fprintf(stream, "Tag ID...............: 0x%x\n", pud->tag);
    fprintf(stream, "Version..............: %x\n", pud->version);
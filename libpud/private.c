@@ -91,3 +91,147 @@ dim2str(Pud_Dimensions dim)
      }
    return "<INVALID DIMENSIONS>";
 }
+
+/*
+ * Arena: once DIM has been read, the size of every array of a parsed PUD
+ * is known (the UNIT length comes from the sections directory), so they
+ * are all carved out of a single allocation.
+ */
+
+enum
+{
+   ARENA_MTXM,
+   ARENA_SQM,
+   ARENA_REGM,
+   ARENA_OILM,
+   ARENA_UNIT,
+   ARENA_FILENAME,
+   ARENA_LAST
+};
+
+static size_t
+_arena_layout(const Pud    *pud,
+              unsigned int  tiles,
+              size_t        name_len,
+              size_t        off[ARENA_LAST])
+{
+   const size_t units = pud_section_length_get(pud, PUD_SECTION_UNIT) / 8;
+   const size_t sizes[ARENA_LAST] = {
+      [ARENA_MTXM]     = tiles * sizeof(uint16_t),
+      [ARENA_SQM]      = tiles * sizeof(uint16_t),
+      [ARENA_REGM]     = tiles * sizeof(uint16_t),
+      [ARENA_OILM]     = tiles * sizeof(uint8_t),
+      [ARENA_UNIT]     = units * sizeof(Pud_Unit_Data),
+      [ARENA_FILENAME] = name_len
+   };
+   size_t size = 0;
+   unsigned int i;
+
+   for (i = 0; i < ARENA_LAST; i++)
+     {
+        off[i] = size;
+        size += (sizes[i] + PUD_CACHELINE_SIZE - 1) & ~(size_t)(PUD_CACHELINE_SIZE - 1);
+     }
+
+   return size;
+}
+
+Pud_Bool
+pud_arena_setup(Pud *pud)
+{
+   unsigned char *mem;
+   size_t off[ARENA_LAST], size, name_len;
+   char *name = NULL;
+
+   name_len = (pud->filename) ? strlen(pud->filename) + 1 : 0;
+   size = _arena_layout(pud, pud->tiles, name_len, off);
+
+#if defined(__linux__) || (defined(__APPLE__) && defined(__MACH__))
+   if (posix_memalign((void **)&mem, PUD_CACHELINE_SIZE, size) != 0)
+     mem = NULL;
+#else
+   mem = malloc(size);
+#endif
+   if (!mem) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+
+   if (name_len)
+     {
+        name = (char *)(mem + off[ARENA_FILENAME]);
+        memcpy(name, pud->filename, name_len);
+     }
+
+   /* Whatever was decoded will be decoded again, in the new arena */
+   pud_array_free(pud, pud->filename);
+   pud_array_free(pud, pud->tiles_map);
+   pud_array_free(pud, pud->movement_map);
+   pud_array_free(pud, pud->action_map);
+   pud_array_free(pud, pud->oil_map);
+   pud_array_free(pud, pud->units);
+   free(pud->arena.mem);
+
+   pud->filename = name;
+   pud->tiles_map = NULL;
+   pud->movement_map = NULL;
+   pud->action_map = NULL;
+   pud->oil_map = NULL;
+   pud->units = NULL;
+   pud->units_count = 0;
+   pud->units_capacity = 0;
+   pud_units_index_invalidate(pud);
+   pud->sections_parsed &= ~(PUD_SECTION_BIT(MTXM) | PUD_SECTION_BIT(SQM) |
+                             PUD_SECTION_BIT(OILM) | PUD_SECTION_BIT(REGM) |
+                             PUD_SECTION_BIT(UNIT));
+
+   pud->arena.mem = mem;
+   pud->arena.size = size;
+   pud->arena.tiles = pud->tiles;
+
+   return PUD_TRUE;
+}
+
+void *
+pud_arena_slot_get(const Pud   *pud,
+                   Pud_Section  sec)
+{
+   size_t off[ARENA_LAST];
+
+   /* The arena does not describe the current dimensions anymore */
+   if ((!pud->arena.mem) || (pud->arena.tiles != pud->tiles))
+     return NULL;
+
+   _arena_layout(pud, pud->arena.tiles, 0, off);
+   switch (sec)
+     {
+      case PUD_SECTION_MTXM: return pud->arena.mem + off[ARENA_MTXM];
+      case PUD_SECTION_SQM:  return pud->arena.mem + off[ARENA_SQM];
+      case PUD_SECTION_REGM: return pud->arena.mem + off[ARENA_REGM];
+      case PUD_SECTION_OILM: return pud->arena.mem + off[ARENA_OILM];
+      case PUD_SECTION_UNIT: return pud->arena.mem + off[ARENA_UNIT];
+      default: return NULL;
+     }
+}
+
+void
+pud_array_free(Pud  *pud,
+               void *ptr)
+{
+   if ((!pud_arena_is(pud, ptr)) && (!pud_borrowed_is(pud, ptr)))
+     free(ptr);
+}
+
+void *
+pud_array_realloc(Pud    *pud,
+                  void   *ptr,
+                  size_t  old_size,
+                  size_t  size)
+{
+   void *mem;
+
+   if ((!pud_arena_is(pud, ptr)) && (!pud_borrowed_is(pud, ptr)))
+     return realloc(ptr, size);
+
+   /* Arrays that are not ours move to their own allocation */
+   mem = malloc(size);
+   if (mem && ptr) memcpy(mem, ptr, (old_size < size) ? old_size : size);
+   return mem;
+}
@@ -7,6 +7,18 @@
 
 #include "pud_private.h"
 
+#if defined(__linux__) || (defined(__APPLE__) && defined(__MACH__))
+# define POSIX_COMPLIANT 1
+#else
+# define POSIX_COMPLIANT 0
+#endif
+
+#if POSIX_COMPLIANT
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
 static const char * const _pud_sections[] =
 {
    "TYPE", "VER ", "DESC", "OWNR", "ERA ",
@@ -56,69 +68,255 @@ pud_section_is_optional(Pud_Section sec)
            (sec == PUD_SECTION_ALOW));
 }
 
-/*
- * TODO FIXME
- * Bad design (this file should not have been parsed like this)
- */
-uint32_t
-pud_go_to_section(Pud         *pud,
-                  Pud_Section  sec)
+static int
+_section_from_tag(const unsigned char *tag)
 {
-   uint8_t b;
-   uint32_t l;
-   char buf[4];
-   const char *sec_str;
+   unsigned int i;
 
-   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
-   if (sec > 19) DIE_RETURN(0, "Invalid section ID [%i]", sec);
+   for (i = 0; i < sizeof(_pud_sections) / sizeof(_pud_sections[0]); i++)
+     {
+        if (!memcmp(tag, _pud_sections[i], 4))
+          return i;
+     }
 
-   sec_str = _pud_sections[sec];
+   return -1;
+}
 
-   /* If the section to search for is before the current section,
-    * rewind the file to catch it. If it is after, do nothing */
-   if (sec <= pud->current_section)
-     pud->ptr = pud->mem_map;
+static Pud_Bool
+_tag_plausible_is(const unsigned char *tag)
+{
+   unsigned int i;
 
-   /* Tell the PUD we are pointing at the last section.
-    * In case of success the pud will be pointing at the section
-    * it had to go.
-    * On failure, it will have to rewind itself on next call */
-   pud->current_section = PUD_SECTION_UNIT;
+   /* Sections we don't know about still have a readable name */
+   for (i = 0; i < 4; i++)
+     {
+        if (!(((tag[i] >= 'A') && (tag[i] <= 'Z')) ||
+              ((tag[i] >= '0') && (tag[i] <= '9')) ||
+              (tag[i] == ' ')))
+          return PUD_FALSE;
+     }
+   return PUD_TRUE;
+}
+
+static void
+_section_record(Pud                 *pud,
+                int                  sec,
+                const unsigned char *hdr,
+                uint32_t             len)
+{
+   /* Only the first occurence of a section is considered */
+   if (pud->sections & (1 << sec)) return;
+
+   pud->section_dir[sec].offset = (hdr + 8) - pud->mem_map;
+   pud->section_dir[sec].length = len;
+   pud->sections |= (1 << sec);
+   PUD_VERBOSE(pud, 2, "Found section %s at offset %u (size = %u)",
+               _pud_sections[sec], pud->section_dir[sec].offset, len);
+}
 
-   READBUF(pud, buf, char, 4, FAIL(0));
+Pud_Bool
+pud_sections_index(Pud *pud)
+{
+   const unsigned char *p = pud->mem_map, *hdr;
+   const unsigned char *const end = pud->mem_map + pud->mem_map_size;
+   Pud_Bool scan = PUD_FALSE;
+   uint32_t len, missing;
+   int sec;
+
+   memset(pud->section_dir, 0, sizeof(pud->section_dir));
+   pud->sections = 0;
 
-   while (pud_mem_map_ok(pud))
+   /* Walk the section headers, and use their length to jump directly
+    * to the next one. A jump must land on a known section (or at the end
+    * of the file): otherwise the length was wrong, and the headers are
+    * searched byte per byte from the last good one, like a plain scan
+    * would. Garbage between sections is skipped the same way. */
+   while (end - p >= 8)
      {
-        if (!strncmp(buf, sec_str, 4))
+        sec = _section_from_tag(p);
+        if ((sec < 0) && ((scan) || (!_tag_plausible_is(p))))
+          {
+             p++;
+             continue;
+          }
+
+        memcpy(&len, p + 4, sizeof(uint32_t));
+        if (len > (uint32_t)(end - p - 8))
           {
-             /* Update current section */
-             pud->current_section = sec;
+             PUD_VERBOSE(pud, 2, "Section header at offset %li has a bogus "
+                         "length (%u).", (long)(p - pud->mem_map), len);
+             if (sec < 0)
+               {
+                  p++;
+                  continue;
+               }
 
-             l = READ32(pud, FAIL(0));
-             return l;
+             /* Its data is still what follows: keep it, up to the end */
+             _section_record(pud, sec, p, (uint32_t)(end - p - 8));
+             p += 8;
+             scan = PUD_TRUE;
+             continue;
           }
 
-        memmove(buf, &(buf[1]), 3 * sizeof(char));
-        b = READ8(pud, FAIL(0));
-        buf[3] = b;
+        if (sec >= 0)
+          _section_record(pud, sec, p, len);
+        else
+          PUD_VERBOSE(pud, 1, "Unknown section [%.4s]. Skipping...", p);
+
+        hdr = p;
+        p += 8 + len;
+        scan = PUD_FALSE;
+        if ((end - p >= 8) && (_section_from_tag(p) < 0))
+          {
+             PUD_VERBOSE(pud, 2, "Section at offset %li is not followed by "
+                         "a section. Scanning...", (long)(hdr - pud->mem_map));
+             p = hdr + 8;
+             scan = PUD_TRUE;
+          }
      }
 
-   return 0;
+   /* A required section may still hide behind a damaged one */
+   missing = ~pud->sections & 0xfffff &
+      ~((1 << PUD_SECTION_ERAX) | (1 << PUD_SECTION_ALOW));
+   if ((pud->sections) && (missing))
+     {
+        for (p = pud->mem_map; (end - p >= 8) && (missing); p++)
+          {
+             sec = _section_from_tag(p);
+             if ((sec < 0) || (!(missing & (1 << sec)))) continue;
+             memcpy(&len, p + 4, sizeof(uint32_t));
+             if (len > (uint32_t)(end - p - 8)) len = end - p - 8;
+             _section_record(pud, sec, p, len);
+             missing &= ~(1 << sec);
+          }
+     }
+
+   return (pud->sections != 0);
+}
+
+Pud_Bool
+pud_section_present_is(const Pud   *pud,
+                       Pud_Section  sec)
+{
+   if ((!pud) || ((unsigned int)sec > 19)) return PUD_FALSE;
+   return !!(pud->sections & (1 << sec));
+}
+
+uint32_t
+pud_section_length_get(const Pud   *pud,
+                       Pud_Section  sec)
+{
+   if (!pud_section_present_is(pud, sec)) return 0;
+   return pud->section_dir[sec].length;
+}
+
+uint32_t
+pud_go_to_section(Pud         *pud,
+                  Pud_Section  sec)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
+   if ((unsigned int)sec > 19) DIE_RETURN(0, "Invalid section ID [%i]", sec);
+
+   if (!(pud->sections & (1 << sec)))
+     return 0;
+
+   pud->ptr = pud->mem_map + pud->section_dir[sec].offset;
+   return pud->section_dir[sec].length;
 }
 
 
+static void
+_borrowed_forget(Pud *pud)
+{
+   /* Arrays borrowed by a view die with the memory map */
+   if (pud_borrowed_is(pud, pud->tiles_map)) pud->tiles_map = NULL;
+   if (pud_borrowed_is(pud, pud->movement_map)) pud->movement_map = NULL;
+   if (pud_borrowed_is(pud, pud->action_map)) pud->action_map = NULL;
+   if (pud_borrowed_is(pud, pud->oil_map)) pud->oil_map = NULL;
+   if (pud_borrowed_is(pud, pud->units))
+     {
+        pud->units = NULL;
+        pud->units_count = 0;
+        pud->units_capacity = 0;
+        pud_units_index_invalidate(pud);
+     }
+}
+
+static Pud_Bool
+_mode_check(Pud_Open_Mode mode)
+{
+   if ((mode & PUD_OPEN_MODE_LAZY) && (!(mode & PUD_OPEN_MODE_R)))
+     DIE_RETURN(PUD_FALSE, "Lazy mode requires PUD_OPEN_MODE_R");
+   if ((mode & PUD_OPEN_MODE_VIEW) &&
+       ((mode & PUD_OPEN_MODE_W) || (!(mode & PUD_OPEN_MODE_R))))
+     DIE_RETURN(PUD_FALSE, "A view can only be opened read-only");
+   return PUD_TRUE;
+}
+
+static void
+_mem_map_release(Pud *pud)
+{
+   if (!pud->mem_map) return;
+
+   _borrowed_forget(pud);
+   if (pud->mem_map_mmap)
+     pud_munmap(pud->mem_map, pud->mem_map_size);
+   else if (pud->mem_map_owned)
+     free(pud->mem_map);
+
+   pud->mem_map = NULL;
+   pud->ptr = NULL;
+   pud->mem_map_size = 0;
+   pud->mem_map_mmap = 0;
+   pud->mem_map_owned = 0;
+}
+
+static void
+_mem_map_set(Pud           *pud,
+             unsigned char *map,
+             size_t         size)
+{
+   pud->mem_map = map;
+   pud->mem_map_size = size;
+   pud->ptr = pud->mem_map;
+
+   /* Build the sections directory once and for all */
+   pud_sections_index(pud);
+   pud->sections_parsed = 0;
+   pud->dirty = 0;
+   pud->layout_stale = 0;
+}
+
+#if POSIX_COMPLIANT
+static void
+_file_id_get(Pud        *pud,
+             const char *file)
+{
+   struct stat st;
+
+   memset(&(pud->file_id), 0, sizeof(pud->file_id));
+   if (stat(file, &st) != 0) return;
+   pud->file_id.dev = st.st_dev;
+   pud->file_id.ino = st.st_ino;
+   pud->file_id.mtime = st.st_mtime;
+}
+#else
+# define _file_id_get(pud_, file_) memset(&((pud_)->file_id), 0, sizeof((pud_)->file_id))
+#endif
+
 static Pud_Bool
 _open(Pud           *pud,
       const char    *file,
       Pud_Open_Mode  mode)
 {
+   unsigned char *map;
+   size_t size;
+
+   if (!_mode_check(mode)) return PUD_FALSE;
+
    /* Close the file if was already open */
-   if (pud->mem_map)
-     {
-        pud_munmap(pud->mem_map, pud->mem_map_size);
-        pud->mem_map = NULL;
-     }
-   if (pud->filename) free(pud->filename);
+   _mem_map_release(pud);
+   pud_array_free(pud, pud->filename);
 
    /* Copy the filename */
    pud->filename = strdup(file); /* XXX Not a fan of strdup() ... */
@@ -129,17 +327,20 @@ _open(Pud           *pud,
    /* Open */
    if (mode & PUD_OPEN_MODE_R)
      {
-        pud->mem_map = pud_mmap(file, &(pud->mem_map_size));
-        if (pud->mem_map == NULL)
+        /* Before the mapping: if the file is replaced in between, it will
+         * not be mistaken for the mapped one */
+        _file_id_get(pud, file);
+        map = pud_mmap(file, &size);
+        if (map == NULL)
           DIE_GOTO(err_ff, "Failed to mmap() [%s] %s", file, strerror(errno));
 
-        pud->ptr = pud->mem_map;
+        pud->mem_map_mmap = 1;
+        _mem_map_set(pud, map, size);
      }
    else
      {
-        pud->mem_map = NULL;
-        pud->ptr = NULL;
-        pud->mem_map_size = 0;
+        pud->sections = 0;
+        pud->sections_parsed = PUD_SECTIONS_ALL;
      }
 
    return PUD_TRUE;
@@ -161,6 +362,7 @@ pud_open_new(const char    *file,
    if (!pud) DIE_GOTO(err, "Failed to alloc Pud: %s", strerror(errno));
 
    pud->open_mode = mode;
+   pud->sections_parsed = PUD_SECTIONS_ALL;
 
    if (file)
      {
@@ -192,6 +394,7 @@ void
 pud_tag_generate(Pud *pud)
 {
    pud->tag = rand() % UINT32_MAX;
+   pud->dirty |= PUD_SECTION_BIT(TYPE);
 }
 
 Pud *
@@ -221,26 +424,73 @@ err:
    return NULL;
 }
 
+Pud *
+pud_open_memory(const void           *buf,
+                size_t                len,
+                Pud_Open_Mode         mode,
+                Pud_Memory_Ownership  ownership)
+{
+   Pud *pud;
+
+   if ((!buf) || (len == 0)) DIE_RETURN(NULL, "Invalid input buffer");
+   if (!(mode & PUD_OPEN_MODE_R))
+     DIE_RETURN(NULL, "A buffer must be opened with PUD_OPEN_MODE_R");
+   if (!_mode_check(mode)) return NULL;
+
+   pud = calloc(1, sizeof(Pud));
+   if (!pud) DIE_RETURN(NULL, "Failed to alloc Pud: %s", strerror(errno));
+
+   pud->open_mode = mode;
+
+   /* The buffer is never written to */
+   _mem_map_set(pud, (unsigned char *)buf, len);
+
+   if (!pud_parse(pud))
+     DIE_GOTO(err, "Failed to parse PUD");
+
+   /* Only take the buffer once we are sure to succeed */
+   pud->mem_map_owned = (ownership == PUD_MEMORY_OWN);
+
+   return pud;
+
+err:
+   pud_close(pud);
+   return NULL;
+}
+
 Pud_Bool
 pud_reopen(Pud           *pud,
            const char    *file,
            Pud_Open_Mode  mode)
 {
    if ((!pud) || (!file)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
-   return _open(pud, file, mode);
+   if (!_open(pud, file, mode)) return PUD_FALSE;
+   pud_units_index_invalidate(pud);
+
+   /* Nothing of the previous file may be mixed with the new one: the
+    * headers (and the dimensions, which reset the arena) are decoded
+    * again, and everything else too unless the new mode is lazy */
+   if ((mode & PUD_OPEN_MODE_R) && (!pud_parse(pud)))
+     DIE_RETURN(PUD_FALSE, "Failed to parse PUD");
+
+   PUD_MINIMAP_DAMAGE(pud, 0, 0, pud->map_w, pud->map_h);
+   return PUD_TRUE;
 }
 
 void
 pud_close(Pud *pud)
 {
    if (!pud) return;
-   if (pud->mem_map) pud_munmap(pud->mem_map, pud->mem_map_size);
-   free(pud->filename);
-   free(pud->units);
-   free(pud->tiles_map);
-   free(pud->action_map);
-   free(pud->movement_map);
-   free(pud->oil_map);
+   if (pud->minimap) pud->minimap->pud = NULL;
+   pud_units_index_free(pud);
+   _mem_map_release(pud);
+   pud_array_free(pud, pud->filename);
+   pud_array_free(pud, pud->units);
+   pud_array_free(pud, pud->tiles_map);
+   pud_array_free(pud, pud->action_map);
+   pud_array_free(pud, pud->movement_map);
+   pud_array_free(pud, pud->oil_map);
+   free(pud->arena.mem);
    free(pud);
 }
 
@@ -252,35 +502,107 @@ pud_verbose_set(Pud *pud,
      pud->verbose = lvl;
 }
 
+/* Indexed by Pud_Section. Sections are decoded in this order */
+static Pud_Bool (*const _pud_parsers[20])(Pud *pud) =
+{
+   [PUD_SECTION_TYPE] = pud_parse_type,
+   [PUD_SECTION_VER]  = pud_parse_ver,
+   [PUD_SECTION_DESC] = pud_parse_desc,
+   [PUD_SECTION_OWNR] = pud_parse_ownr,
+   [PUD_SECTION_ERA]  = pud_parse_era, // Also parses ERAX
+   [PUD_SECTION_ERAX] = NULL,
+   [PUD_SECTION_DIM]  = pud_parse_dim,
+   [PUD_SECTION_UDTA] = pud_parse_udta,
+   [PUD_SECTION_ALOW] = pud_parse_alow,
+   [PUD_SECTION_UGRD] = pud_parse_ugrd,
+   [PUD_SECTION_SIDE] = pud_parse_side,
+   [PUD_SECTION_SGLD] = pud_parse_sgld,
+   [PUD_SECTION_SLBR] = pud_parse_slbr,
+   [PUD_SECTION_SOIL] = pud_parse_soil,
+   [PUD_SECTION_AIPL] = pud_parse_aipl,
+   [PUD_SECTION_MTXM] = pud_parse_mtxm,
+   [PUD_SECTION_SQM]  = pud_parse_sqm,
+   [PUD_SECTION_OILM] = pud_parse_oilm,
+   [PUD_SECTION_REGM] = pud_parse_regm,
+   [PUD_SECTION_UNIT] = pud_parse_unit,
+};
+
+Pud_Bool
+pud_sections_load(Pud      *pud,
+                  uint32_t  mask)
+{
+   unsigned int i;
+
+   /* Nothing to decode when the PUD was not read from a file */
+   if (!pud->mem_map) return PUD_TRUE;
+
+   mask &= ~(pud->sections_parsed);
+   for (i = 0; mask != 0; i++, mask >>= 1)
+     {
+        if (!(mask & 1)) continue;
+        if (_pud_parsers[i])
+          {
+             if (!_pud_parsers[i](pud))
+               DIE_RETURN(PUD_FALSE, "Failed to parse %s", _pud_sections[i]);
+             PUD_VERBOSE(pud, 2, "Section %s decoded", _pud_sections[i]);
+
+             /* The units, their sizes or the map have changed */
+             if ((i == PUD_SECTION_UNIT) || (i == PUD_SECTION_UDTA) ||
+                 (i == PUD_SECTION_DIM))
+               pud_units_index_invalidate(pud);
+          }
+        pud->sections_parsed |= (1 << i);
+     }
+
+   return PUD_TRUE;
+}
+
+Pud_Bool
+pud_section_load(Pud         *pud,
+                 Pud_Section  sec)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+   if ((unsigned int)sec > 19) DIE_RETURN(PUD_FALSE, "Invalid section ID [%i]", sec);
+
+   PUD_SECTIONS_LOAD(pud, 1u << sec, PUD_FALSE);
+   return PUD_TRUE;
+}
+
+void
+pud_section_dirty_set(Pud         *pud,
+                      Pud_Section  sec)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
+   if ((unsigned int)sec > 19) DIE_RETURN(VOID, "Invalid section ID [%i]", sec);
+
+   pud->dirty |= (1u << sec);
+}
+
+Pud_Bool
+pud_section_dirty_is(const Pud   *pud,
+                     Pud_Section  sec)
+{
+   if ((!pud) || ((unsigned int)sec > 19)) return PUD_FALSE;
+   return !!(pud->dirty & (1u << sec));
+}
+
 Pud_Bool
 pud_parse(Pud *pud)
 {
-   pud->sections = 0;
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+
+   uint32_t mask = PUD_SECTIONS_ALL;
+
+   /* In lazy mode, only the headers are decoded now */
+   if (pud->open_mode & PUD_OPEN_MODE_LAZY)
+     mask &= ~PUD_SECTIONS_LAZY;
 
-#define PARSE_SEC(sec) \
-   if (!pud_parse_ ## sec(pud)) DIE_RETURN(PUD_FALSE, "Failed to parse " #sec)
-
-   PARSE_SEC(type);
-   PARSE_SEC(ver);
-   PARSE_SEC(desc);
-   PARSE_SEC(ownr);
-   PARSE_SEC(era); // Also parses ERAX
-   PARSE_SEC(dim);
-   PARSE_SEC(udta);
-   PARSE_SEC(alow);
-   PARSE_SEC(ugrd);
-   PARSE_SEC(side);
-   PARSE_SEC(sgld);
-   PARSE_SEC(slbr);
-   PARSE_SEC(soil);
-   PARSE_SEC(aipl);
-   PARSE_SEC(mtxm);
-   PARSE_SEC(sqm);
-   PARSE_SEC(oilm);
-   PARSE_SEC(regm);
-   PARSE_SEC(unit);
-
-#undef PARSE_SEC
+   /* ERA also parses ERAX */
+   mask &= ~PUD_SECTION_BIT(ERAX);
+   pud->sections_parsed &= ~mask;
+   if (!pud_sections_load(pud, mask))
+     return PUD_FALSE;
+   pud->sections_parsed |= PUD_SECTION_BIT(ERAX);
 
    /* Is assumed valid */
    pud->init = 1;
@@ -295,6 +617,7 @@ pud_tile_at(const Pud *pud,
 {
    if (((unsigned int)(x * y)) >= (unsigned int)pud->tiles)
      DIE_RETURN(0, "Invalid coordinates %i,%i", x, y);
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), 0);
 
    return pud->tiles_map[y * pud->map_w + x];
 }
@@ -305,6 +628,26 @@ pud_era_set(Pud     *pud,
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
    pud->era = era;
+   pud->dirty |= (PUD_SECTION_BIT(ERA) | PUD_SECTION_BIT(ERAX));
+   PUD_MINIMAP_DAMAGE(pud, 0, 0, pud->map_w, pud->map_h);
+}
+
+/* Fills by doubling copies, so most of the work is done by memcpy() */
+static void
+_tiles_fill(uint16_t *dst,
+            uint16_t  tile,
+            size_t    count)
+{
+   size_t done = 1, chunk;
+
+   if (count == 0) return;
+   dst[0] = tile;
+   while (done < count)
+     {
+        chunk = (done < count - done) ? done : count - done;
+        memcpy(dst + done, dst, chunk * sizeof(uint16_t));
+        done += chunk;
+     }
 }
 
 void
@@ -314,7 +657,13 @@ pud_dimensions_set(Pud            *pud,
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
 
    size_t size;
-   unsigned int i;
+
+   /* The maps are reset: they must not be decoded later */
+   pud->sections_parsed |= (PUD_SECTION_BIT(MTXM) | PUD_SECTION_BIT(SQM) |
+                            PUD_SECTION_BIT(OILM) | PUD_SECTION_BIT(REGM));
+   pud->dirty |= (PUD_SECTION_BIT(DIM) | PUD_SECTION_BIT(MTXM) |
+                  PUD_SECTION_BIT(SQM) | PUD_SECTION_BIT(OILM) |
+                  PUD_SECTION_BIT(REGM));
 
    pud->dims = dims;
    pud_dimensions_to_size(dims, &(pud->map_w), &(pud->map_h));
@@ -323,280 +672,608 @@ pud_dimensions_set(Pud            *pud,
    size = pud->tiles * sizeof(uint16_t);
 
    /* Set by default light ground */
-   pud->tiles_map = realloc(pud->tiles_map, size);
+   pud->tiles_map = pud_array_realloc(pud, pud->tiles_map, 0, size);
    if (!pud->tiles_map) DIE_RETURN(VOID, "Failed to allocate memory");
-   for (i = 0; i < pud->tiles; i++)
-     pud->tiles_map[i] = 0x0050;
+   _tiles_fill(pud->tiles_map, 0x0050, pud->tiles);
 
-   pud->action_map = realloc(pud->action_map, size);
+   pud->action_map = pud_array_realloc(pud, pud->action_map, 0, size);
    if (!pud->action_map) DIE_RETURN(VOID, "Failed to allocate memory");
    memset(pud->action_map, 0, size);
 
-   pud->movement_map = realloc(pud->movement_map, size);
+   pud->movement_map = pud_array_realloc(pud, pud->movement_map, 0, size);
    if (!pud->movement_map) DIE_RETURN(VOID, "Failed to allocate memory");
    memset(pud->movement_map, 0, size);
+
+   pud_units_index_invalidate(pud);
+   PUD_MINIMAP_DAMAGE(pud, 0, 0, pud->map_w, pud->map_h);
 }
 
-Pud_Bool
-pud_write(const Pud  *pud,
-          const char *file)
-{
-   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+/*
+ * Serialization: the exact size of the output is known in advance, so
+ * the whole PUD is built in a single buffer, which is then written at
+ * once.
+ */
 
-   const Pud *p = pud; // Shortcut
-   FILE *f;
-   uint8_t b;
-   uint16_t w;
-   uint32_t l;
-   unsigned int i, j, map_len, units_len;
-   const char *savefile = (file) ? file : pud->filename;
+static inline unsigned char *
+_put8(unsigned char *o,
+      uint8_t        v)
+{
+   o[0] = v;
+   return o + 1;
+}
 
-   map_len = p->tiles * sizeof(uint16_t);
-   units_len = p->units_count * sizeof(Pud_Unit_Data);
+static inline unsigned char *
+_put16(unsigned char *o,
+       uint16_t       v)
+{
+   o[0] = v & 0xff;
+   o[1] = (v >> 8) & 0xff;
+   return o + 2;
+}
 
-   f = fopen(savefile, "wb");
-   if (!f) DIE_RETURN(PUD_FALSE, "Failed to open [%s]", savefile);
-   setvbuf(f, NULL, _IOFBF, 0); /* Fully buffered */
+static inline unsigned char *
+_put32(unsigned char *o,
+       uint32_t       v)
+{
+   o[0] = v & 0xff;
+   o[1] = (v >> 8) & 0xff;
+   o[2] = (v >> 16) & 0xff;
+   o[3] = (v >> 24) & 0xff;
+   return o + 4;
+}
 
-#define W8(val, nb) \
+/* Fields with one value per player (8 players, 7 unusable, neutral) */
+#define PUT_PER_PLAYER(o, field, put) \
    do { \
-      for (j = 0; j < nb; j++) fwrite(&(val), sizeof(uint8_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
+      for (i = 0; i < 8; i++) o = put(o, (field).players[i]); \
+      for (i = 0; i < 7; i++) o = put(o, (field).unusable[i]); \
+      o = put(o, (field).neutral); \
    } while (0)
 
-#define W16(val, nb) \
-   do { \
-      for (j = 0; j < nb; j++) fwrite(&(val), sizeof(uint16_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+static Pud_Bool
+_section_written_is(const Pud   *p,
+                    Pud_Section  sec)
+{
+   switch (sec)
+     {
+      case PUD_SECTION_ERAX: return p->has_erax;
+      case PUD_SECTION_ALOW: return (p->default_allow == 0);
+      default: return PUD_TRUE;
+     }
+}
 
-#define W32(val, nb) \
-   do { \
-      for (j = 0; j < nb; j++) fwrite(&(val), sizeof(uint32_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+/* Size of the data of a section, header excluded */
+static uint32_t
+_section_size(const Pud   *p,
+              Pud_Section  sec)
+{
+   switch (sec)
+     {
+      case PUD_SECTION_TYPE: return 16;
+      case PUD_SECTION_VER:  return 2;
+      case PUD_SECTION_DESC: return 32;
+      case PUD_SECTION_OWNR: return 16;
+      case PUD_SECTION_ERA:  return 2;
+      case PUD_SECTION_ERAX: return 2;
+      case PUD_SECTION_DIM:  return 4;
+      case PUD_SECTION_UDTA: return 5696;
+      case PUD_SECTION_ALOW: return 384;
+      case PUD_SECTION_UGRD: return 782;
+      case PUD_SECTION_SIDE: return 16;
+      case PUD_SECTION_SGLD: return 32;
+      case PUD_SECTION_SLBR: return 32;
+      case PUD_SECTION_SOIL: return 32;
+      case PUD_SECTION_AIPL: return 16;
+      case PUD_SECTION_MTXM: return p->tiles * sizeof(uint16_t);
+      case PUD_SECTION_SQM:  return p->tiles * sizeof(uint16_t);
+      case PUD_SECTION_OILM: return p->tiles;
+      case PUD_SECTION_REGM: return p->tiles * sizeof(uint16_t);
+      case PUD_SECTION_UNIT: return p->units_count * 8;
+     }
+   return 0;
+}
 
-#define WI8(imm, nb) \
-   do { \
-      b = imm; \
-      for (j = 0; j < nb; j++) fwrite(&(b), sizeof(uint8_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+/* Writes the data of a section (header excluded) and returns the
+ * position right after it */
+static unsigned char *
+_section_serialize(const Pud     *p,
+                   Pud_Section    sec,
+                   unsigned char *o)
+{
+   const Pud_Unit_Characteristics *const ud = p->unit_data;
+   const Pud_Upgrade_Characteristics *const up = p->upgrade;
+   unsigned int i;
 
-#define WI16(imm, nb) \
-   do { \
-      w = imm; \
-      for (j = 0; j < nb; j++) fwrite(&(w), sizeof(uint16_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+   switch (sec)
+     {
+      case PUD_SECTION_TYPE:
+         memcpy(o, "WAR2 MAP", 8);
+         o += 8;
+         o = _put16(o, 0); // Unused
+         o = _put8(o, 0x0a);
+         o = _put8(o, 0xff);
+         o = _put32(o, p->tag);
+         break;
 
-#define WI32(imm, nb) \
-   do { \
-      l = imm; \
-      for (j = 0; j < nb; j++) fwrite(&(l), sizeof(uint32_t), 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+      case PUD_SECTION_VER:
+         o = _put16(o, p->version);
+         break;
 
-#define WSEC(sec, len) \
-   do { \
-      fwrite(_pud_sections[sec], sizeof(int8_t), 4, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-      W32(len, 1); \
-   } while (0)
+      case PUD_SECTION_DESC:
+         memcpy(o, p->description, 32);
+         o += 32;
+         break;
 
-#define WISEC(sec, len) \
-   do { \
-      fwrite(_pud_sections[sec], sizeof(int8_t), 4, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-      WI32(len, 1); \
-   } while (0)
+      case PUD_SECTION_OWNR:
+         PUT_PER_PLAYER(o, p->owner, _put8);
+         break;
 
-#define WSTR(str) \
-   do { \
-      fwrite(str, sizeof(int8_t), sizeof(str) - 1, f); \
-      PUD_CHECK_FERROR(f, PUD_FALSE); \
-   } while (0)
+      case PUD_SECTION_ERA:
+      case PUD_SECTION_ERAX:
+         o = _put16(o, p->era);
+         break;
 
-   /* Section TYPE */
-   WISEC(PUD_SECTION_TYPE, 16);
-   WSTR("WAR2 MAP");
-   WI8(0, 2);           // Unused
-   WI8(0x0a, 1);
-   WI8(0xff, 1);
-   W32(p->tag, 1);
-
-   /* Section VER */
-   WISEC(PUD_SECTION_VER, 2);
-   WI16(p->version, 1);  // Version
-
-   /* Section DESC */
-   WISEC(PUD_SECTION_DESC, 32);
-   for (i = 0; i < 32; ++i) W8(p->description[i], 1);
-
-   /* Section OWNR */
-   WISEC(PUD_SECTION_OWNR, 16);
-   for (i = 0; i < 8; i++) W8(p->owner.players[i], 1);
-   for (i = 0; i < 7; i++) W8(p->owner.unusable[i], 1);
-   W8(p->owner.neutral, 1);
-
-   /* Section ERA */
-   WISEC(PUD_SECTION_ERA, 2);
-   W16(p->era, 1);
-
-   /* Section ERAX */
-   if (p->has_erax)
-     {
-        WISEC(PUD_SECTION_ERAX, 2);
-        W16(p->era, 1);
-     }
-
-   /* Section DIM */
-   WISEC(PUD_SECTION_DIM, 4);
-   W16(p->map_w, 1);
-   W16(p->map_h, 1);
-
-   /* Section UDTA */
-   WISEC(PUD_SECTION_UDTA, 5696);
-   WI16(p->default_udta, 1);
-   for (i = 0; i < 110; i++) W16(p->unit_data[i].overlap_frames, 1);
-   for (i = 0; i < 508; i++) W16(p->unkwown[i], 1);
-   for (i = 0; i < 110; i++) W32(p->unit_data[i].sight, 1);
-   for (i = 0; i < 110; i++) W16(p->unit_data[i].hp, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].has_magic, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].build_time, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].gold_cost, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].lumber_cost, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].oil_cost, 1);
-   // FIXME I think the words are switched!
-   for (i = 0; i < 110; i++)
-     {
-        l = ((p->unit_data[i].size_w << 16) & 0xffff0000) | (p->unit_data[i].size_h & 0x0000ffff);
-        W32(l, 1);
-     }
-   for (i = 0; i < 110; i++)
-     {
-        l = ((p->unit_data[i].box_w << 16) & 0xffff0000) | (p->unit_data[i].box_h & 0x0000ffff);
-        W32(l, 1);
-     }
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].range, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].computer_react_range, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].human_react_range, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].armor, 1);
-   for (i = 0; i < 110; i++) WI8(p->unit_data[i].rect_sel, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].priority, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].basic_damage, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].piercing_damage, 1);
-   for (i = 0; i < 110; i++) WI8(p->unit_data[i].weapons_upgradable, 1);
-   for (i = 0; i < 110; i++) WI8(p->unit_data[i].armor_upgradable, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].missile_weapon, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].type, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].decay_rate, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].annoy, 1);
-   for (i = 0; i < 58; i++) W8(p->unit_data[i].mouse_right_btn, 1);
-   for (i = 0; i < 110; i++) W16(p->unit_data[i].point_value, 1);
-   for (i = 0; i < 110; i++) W8(p->unit_data[i].can_target, 1);
-   for (i = 0; i < 110; i++) W32(p->unit_data[i].flags, 1);
-   // WI16(0, 127); // Obsolete data (do not print!!)
-
-   /* Section ALOW */
-   if (p->default_allow == 0)
-     {
-        WISEC(PUD_SECTION_ALOW, 384);
-        fwrite(&p->unit_alow, sizeof(uint32_t), 16, f);
-        fwrite(&p->spell_start, sizeof(uint32_t), 16, f);
-        fwrite(&p->spell_alow, sizeof(uint32_t), 16, f);
-        fwrite(&p->spell_acq, sizeof(uint32_t), 16, f);
-        fwrite(&p->up_alow, sizeof(uint32_t), 16, f);
-        fwrite(&p->up_acq, sizeof(uint32_t), 16, f);
-        PUD_CHECK_FERROR(f, PUD_FALSE);
-     }
-
-   /* Section UGRD */
-   WISEC(PUD_SECTION_UGRD, 782);
-   WI16(p->default_ugrd, 1);
-   for (i = 0; i < 52; i++) W8(p->upgrade[i].time, 1);
-   for (i = 0; i < 52; i++) W16(p->upgrade[i].gold, 1);
-   for (i = 0; i < 52; i++) W16(p->upgrade[i].lumber, 1);
-   for (i = 0; i < 52; i++) W16(p->upgrade[i].oil, 1);
-   for (i = 0; i < 52; i++) W16(p->upgrade[i].icon, 1);
-   for (i = 0; i < 52; i++) W16(p->upgrade[i].group, 1);
-   for (i = 0; i < 52; i++) W32(p->upgrade[i].flags, 1);
-
-   /* Section SIDE */
-   WISEC(PUD_SECTION_SIDE, 16);
-   fwrite(&p->side, sizeof(uint8_t), 16, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_DIM:
+         o = _put16(o, p->map_w);
+         o = _put16(o, p->map_h);
+         break;
 
-   /* Section SGLD */
-   WISEC(PUD_SECTION_SGLD, 32);
-   fwrite(&p->sgld, sizeof(uint16_t), 16, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_UDTA:
+         o = _put16(o, p->default_udta);
+         for (i = 0; i < 110; i++) o = _put16(o, ud[i].overlap_frames);
+         for (i = 0; i < 508; i++) o = _put16(o, p->unkwown[i]);
+         for (i = 0; i < 110; i++) o = _put32(o, ud[i].sight);
+         for (i = 0; i < 110; i++) o = _put16(o, ud[i].hp);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].has_magic);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].build_time);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].gold_cost);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].lumber_cost);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].oil_cost);
+         // FIXME I think the words are switched!
+         for (i = 0; i < 110; i++)
+           o = _put32(o, ((ud[i].size_w << 16) & 0xffff0000) | (ud[i].size_h & 0x0000ffff));
+         for (i = 0; i < 110; i++)
+           o = _put32(o, ((ud[i].box_w << 16) & 0xffff0000) | (ud[i].box_h & 0x0000ffff));
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].range);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].computer_react_range);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].human_react_range);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].armor);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].rect_sel);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].priority);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].basic_damage);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].piercing_damage);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].weapons_upgradable);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].armor_upgradable);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].missile_weapon);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].type);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].decay_rate);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].annoy);
+         for (i = 0; i < 58; i++) o = _put8(o, ud[i].mouse_right_btn);
+         for (i = 0; i < 110; i++) o = _put16(o, ud[i].point_value);
+         for (i = 0; i < 110; i++) o = _put8(o, ud[i].can_target);
+         for (i = 0; i < 110; i++) o = _put32(o, ud[i].flags);
+         // Obsolete data (127 words) are not written
+         break;
 
-   /* Section SLBR */
-   WISEC(PUD_SECTION_SLBR, 32);
-   fwrite(&p->slbr, sizeof(uint16_t), 16, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_ALOW:
+         PUT_PER_PLAYER(o, p->unit_alow, _put32);
+         PUT_PER_PLAYER(o, p->spell_start, _put32);
+         PUT_PER_PLAYER(o, p->spell_alow, _put32);
+         PUT_PER_PLAYER(o, p->spell_acq, _put32);
+         PUT_PER_PLAYER(o, p->up_alow, _put32);
+         PUT_PER_PLAYER(o, p->up_acq, _put32);
+         break;
 
-   /* Section SOIL */
-   WISEC(PUD_SECTION_SOIL, 32);
-   fwrite(&p->soil, sizeof(uint16_t), 16, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_UGRD:
+         o = _put16(o, p->default_ugrd);
+         for (i = 0; i < 52; i++) o = _put8(o, up[i].time);
+         for (i = 0; i < 52; i++) o = _put16(o, up[i].gold);
+         for (i = 0; i < 52; i++) o = _put16(o, up[i].lumber);
+         for (i = 0; i < 52; i++) o = _put16(o, up[i].oil);
+         for (i = 0; i < 52; i++) o = _put16(o, up[i].icon);
+         for (i = 0; i < 52; i++) o = _put16(o, up[i].group);
+         for (i = 0; i < 52; i++) o = _put32(o, up[i].flags);
+         break;
 
-   /* Section AIPL */
-   WISEC(PUD_SECTION_AIPL, 16);
-   fwrite(&p->ai, sizeof(uint8_t), 16, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_SIDE: PUT_PER_PLAYER(o, p->side, _put8); break;
+      case PUD_SECTION_SGLD: PUT_PER_PLAYER(o, p->sgld, _put16); break;
+      case PUD_SECTION_SLBR: PUT_PER_PLAYER(o, p->slbr, _put16); break;
+      case PUD_SECTION_SOIL: PUT_PER_PLAYER(o, p->soil, _put16); break;
+      case PUD_SECTION_AIPL: PUT_PER_PLAYER(o, p->ai, _put8); break;
 
-   /* Section MTMX */
-   WSEC(PUD_SECTION_MTXM, map_len);
-   fwrite(p->tiles_map, sizeof(uint16_t), p->tiles, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_MTXM:
+         pud_le16_store(o, p->tiles_map, p->tiles);
+         o += p->tiles * sizeof(uint16_t);
+         break;
 
-   /* Section SQM */
-   WSEC(PUD_SECTION_SQM, map_len);
-   fwrite(p->movement_map, sizeof(uint16_t), p->tiles, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_SQM:
+         pud_le16_store(o, p->movement_map, p->tiles);
+         o += p->tiles * sizeof(uint16_t);
+         break;
 
-   /* Section OILM */
-   WSEC(PUD_SECTION_OILM, p->tiles);
-   WI8(0, p->tiles);
+      case PUD_SECTION_OILM:
+         /* Obsolete: always zeroed */
+         memset(o, 0, p->tiles);
+         o += p->tiles;
+         break;
 
-   /* Section REGM */
-   WSEC(PUD_SECTION_REGM, map_len);
-   fwrite(p->action_map, sizeof(uint16_t), p->tiles, f);
-   PUD_CHECK_FERROR(f, PUD_FALSE);
+      case PUD_SECTION_REGM:
+         pud_le16_store(o, p->action_map, p->tiles);
+         o += p->tiles * sizeof(uint16_t);
+         break;
+
+      case PUD_SECTION_UNIT:
+         if ((!PUD_BIG_ENDIAN) && (p->units_count != 0))
+           {
+              /* Same layout in memory and in the file */
+              memcpy(o, p->units, p->units_count * sizeof(Pud_Unit_Data));
+              o += p->units_count * sizeof(Pud_Unit_Data);
+           }
+         else
+           {
+              for (i = 0; i < p->units_count; i++)
+                {
+                   o = _put16(o, p->units[i].x);
+                   o = _put16(o, p->units[i].y);
+                   o = _put8(o, p->units[i].type);
+                   o = _put8(o, p->units[i].owner);
+                   o = _put16(o, p->units[i].alter);
+                }
+           }
+         break;
+     }
+
+   return o;
+}
+
+#undef PUT_PER_PLAYER
+
+static unsigned char *
+_serialize(const Pud *p,
+           size_t    *size_ret)
+{
+   unsigned char *buf, *o;
+   size_t size = 0;
+   unsigned int i;
+
+   for (i = 0; i < 20; i++)
+     if (_section_written_is(p, i))
+       size += 8 + _section_size(p, i);
+
+   buf = malloc(size);
+   if (!buf) DIE_RETURN(NULL, "Failed to allocate memory");
+
+   for (i = 0, o = buf; i < 20; i++)
+     {
+        if (!_section_written_is(p, i)) continue;
+        memcpy(o, _pud_sections[i], 4);
+        o = _put32(o + 4, _section_size(p, i));
+        o = _section_serialize(p, i, o);
+     }
 
-   /* Section UNIT */
-   WSEC(PUD_SECTION_UNIT, units_len);
-   for (i = 0; i < p->units_count; ++i)
+   *size_ret = size;
+   return buf;
+}
+
+#if POSIX_COMPLIANT
+/* Writes at the current position when 'offset' is negative */
+static Pud_Bool
+_fd_write(int                  fd,
+          const unsigned char *buf,
+          size_t               size,
+          off_t                offset,
+          const char          *file)
+{
+   ssize_t n;
+
+   while (size > 0)
      {
-        W16(p->units[i].x, 1);
-        W16(p->units[i].y, 1);
-        W8(p->units[i].type, 1);
-        W8(p->units[i].owner, 1);
-        W16(p->units[i].alter, 1);
+        if (offset < 0) n = write(fd, buf, size);
+        else n = pwrite(fd, buf, size, offset);
+        if (n < 0)
+          {
+             if (errno == EINTR) continue;
+             DIE_RETURN(PUD_FALSE, "Failed to write [%s]: %s", file, strerror(errno));
+          }
+        buf += n;
+        size -= n;
+        if (offset >= 0) offset += n;
      }
 
-#undef WSTR
-#undef WISEC
-#undef WI32
-#undef WI16
-#undef WI8
-#undef W32
-#undef W16
-#undef W8
+   return PUD_TRUE;
+}
+
+static Pud_Bool
+_write_plain(const char          *file,
+             const unsigned char *buf,
+             size_t               size,
+             Pud_Bool             sync)
+{
+   int fd;
+
+   fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+   if (fd < 0) DIE_RETURN(PUD_FALSE, "Failed to open [%s]: %s", file, strerror(errno));
+
+   if ((!_fd_write(fd, buf, size, -1, file)) ||
+       (sync && (fsync(fd) != 0)))
+     {
+        ERR("Failed to save [%s]: %s", file, strerror(errno));
+        close(fd);
+        return PUD_FALSE;
+     }
+
+   if (close(fd) != 0)
+     DIE_RETURN(PUD_FALSE, "Failed to close [%s]: %s", file, strerror(errno));
+
+   return PUD_TRUE;
+}
+
+static void
+_dir_sync(const char *file)
+{
+   char *dir, *sep;
+   int fd;
+
+   /* Make the rename() itself durable */
+   dir = strdup(file);
+   if (!dir) return;
+   sep = strrchr(dir, '/');
+   if (sep == dir) sep[1] = '\0'; /* File at the root */
+   else if (sep) *sep = '\0';
+
+   fd = open(sep ? dir : ".", O_RDONLY);
+   if (fd >= 0)
+     {
+        fsync(fd);
+        close(fd);
+     }
+   free(dir);
+}
+
+static Pud_Bool
+_write_atomic(const char          *file,
+              const unsigned char *buf,
+              size_t               size,
+              Pud_Bool             sync)
+{
+   struct stat st;
+   char *tmp;
+   size_t len;
+   int fd;
+   mode_t mode = 0644;
+
+   /* Write into a sibling file, so rename() does not cross filesystems */
+   len = strlen(file);
+   tmp = malloc(len + sizeof(".XXXXXX"));
+   if (!tmp) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   memcpy(tmp, file, len);
+   memcpy(tmp + len, ".XXXXXX", sizeof(".XXXXXX"));
+
+   fd = mkstemp(tmp);
+   if (fd < 0)
+     DIE_GOTO(err_free, "Failed to create temporary file for [%s]: %s",
+              file, strerror(errno));
+
+   /* Keep the permissions of the file being replaced */
+   if (stat(file, &st) == 0) mode = st.st_mode & 07777;
+   if (fchmod(fd, mode) != 0)
+     DIE_GOTO(err_close, "Failed to chmod [%s]: %s", tmp, strerror(errno));
+
+   if (!_fd_write(fd, buf, size, -1, tmp))
+     goto err_close;
+   if (sync && (fsync(fd) != 0))
+     DIE_GOTO(err_close, "Failed to sync [%s]: %s", tmp, strerror(errno));
+   if (close(fd) != 0)
+     DIE_GOTO(err_unlink, "Failed to close [%s]: %s", tmp, strerror(errno));
+
+   if (rename(tmp, file) != 0)
+     DIE_GOTO(err_unlink, "Failed to rename [%s] to [%s]: %s",
+              tmp, file, strerror(errno));
+   if (sync) _dir_sync(file);
+
+   free(tmp);
+   return PUD_TRUE;
+
+err_close:
+   close(fd);
+err_unlink:
+   unlink(tmp);
+err_free:
+   free(tmp);
+   return PUD_FALSE;
+}
+
+/* Can the dirty sections be overwritten in place in 'file'? */
+static Pud_Bool
+_patchable_is(const Pud  *pud,
+              const char *file)
+{
+   struct stat st;
+   unsigned int i;
+   Pud_Bool written, present;
 
-   fclose(f);
+   if ((!pud->mem_map_mmap) || (pud->layout_stale) || (!pud->filename) ||
+       (strcmp(file, pud->filename) != 0))
+     return PUD_FALSE;
+
+   /* The file must not have changed since it was mapped */
+   if ((stat(file, &st) != 0) ||
+       ((size_t)st.st_size != pud->mem_map_size) ||
+       ((uint64_t)st.st_dev != pud->file_id.dev) ||
+       ((uint64_t)st.st_ino != pud->file_id.ino) ||
+       ((int64_t)st.st_mtime != pud->file_id.mtime))
+     return PUD_FALSE;
+
+   for (i = 0; i < 20; i++)
+     {
+        if (!(pud->dirty & (1u << i))) continue;
+
+        written = _section_written_is(pud, i);
+        present = !!(pud->sections & (1u << i));
+        if (written != present)
+          return PUD_FALSE;
+        if (written && (_section_size(pud, i) != pud->section_dir[i].length))
+          return PUD_FALSE;
+     }
 
    return PUD_TRUE;
 }
 
+static Pud_Bool
+_write_patch(Pud      *pud,
+             Pud_Bool  sync)
+{
+   struct stat st;
+   unsigned char *buf = NULL, *tmp;
+   size_t cap = 0;
+   uint32_t len;
+   unsigned int i;
+   int fd;
+   Pud_Bool ret = PUD_FALSE;
+
+   fd = open(pud->filename, O_WRONLY);
+   if (fd < 0)
+     DIE_RETURN(PUD_FALSE, "Failed to open [%s]: %s", pud->filename, strerror(errno));
+
+   for (i = 0; i < 20; i++)
+     {
+        if (!(pud->dirty & pud->sections & (1u << i))) continue;
+
+        len = _section_size(pud, i);
+        if (len > cap)
+          {
+             tmp = realloc(buf, len);
+             if (!tmp) DIE_GOTO(end, "Failed to allocate memory");
+             buf = tmp;
+             cap = len;
+          }
+        _section_serialize(pud, i, buf);
+        if (!_fd_write(fd, buf, len, pud->section_dir[i].offset, pud->filename))
+          goto end;
+        PUD_VERBOSE(pud, 2, "Section %s patched in place", _pud_sections[i]);
+     }
+
+   if (sync && (fsync(fd) != 0))
+     DIE_GOTO(end, "Failed to sync [%s]: %s", pud->filename, strerror(errno));
+   ret = PUD_TRUE;
+
+   /* Writing moved the mtime: this is still the file that was mapped */
+   if (fstat(fd, &st) == 0)
+     pud->file_id.mtime = st.st_mtime;
+
+end:
+   free(buf);
+   if ((close(fd) != 0) && ret)
+     DIE_RETURN(PUD_FALSE, "Failed to close [%s]: %s", pud->filename, strerror(errno));
+   return ret;
+}
+
+#else /* ! POSIX_COMPLIANT */
+
+static Pud_Bool
+_write_plain(const char          *file,
+             const unsigned char *buf,
+             size_t               size,
+             Pud_Bool             sync)
+{
+   FILE *f;
+
+   (void) sync;
+
+   f = fopen(file, "wb");
+   if (!f) DIE_RETURN(PUD_FALSE, "Failed to open [%s]", file);
+   fwrite(buf, size, 1, f);
+   PUD_CHECK_FERROR(f, PUD_FALSE);
+   if (fclose(f) != 0)
+     DIE_RETURN(PUD_FALSE, "Failed to close [%s]: %s", file, strerror(errno));
+
+   return PUD_TRUE;
+}
+
+/* No atomic replacement available */
+# define _write_atomic _write_plain
+
+/* Nor in-place patching */
+# define _patchable_is(pud_, file_) PUD_FALSE
+# define _write_patch(pud_, sync_) PUD_FALSE
+
+#endif
+
+Pud_Bool
+pud_save(Pud            *pud,
+         const char     *file,
+         Pud_Save_Flags  flags)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+   PUD_SECTIONS_LOAD(pud, PUD_SECTIONS_ALL, PUD_FALSE);
+
+   unsigned char *buf;
+   size_t size;
+   Pud_Bool ret, own;
+   const Pud_Bool sync = !(flags & PUD_SAVE_NO_SYNC);
+   const char *savefile = (file) ? file : pud->filename;
+
+   if (!savefile) DIE_RETURN(PUD_FALSE, "No file to write to");
+   own = ((pud->filename) && (!strcmp(savefile, pud->filename)));
+
+   /* Patching in place cannot be atomic: ATOMIC wins */
+   if ((flags & PUD_SAVE_PATCH) && (!(flags & PUD_SAVE_ATOMIC)) &&
+       (_patchable_is(pud, savefile)))
+     {
+        ret = _write_patch(pud, sync);
+        if (ret) pud->dirty = 0;
+        return ret;
+     }
+
+   buf = _serialize(pud, &size);
+   if (!buf) return PUD_FALSE;
+
+   if (flags & PUD_SAVE_ATOMIC)
+     ret = _write_atomic(savefile, buf, size, sync);
+   else
+     ret = _write_plain(savefile, buf, size, sync);
+   free(buf);
+
+   if (ret && own)
+     {
+        pud->dirty = 0;
+        pud->layout_stale = 1;
+     }
+
+   return ret;
+}
+
+Pud_Bool
+pud_write(const Pud  *pud,
+          const char *file)
+{
+   /* pud_write() predates the dirty-state bookkeeping: its signature is
+    * kept, but saving does update that bookkeeping */
+   return pud_save((Pud *)pud, file, PUD_SAVE_NO_SYNC);
+}
+
+unsigned char *
+pud_write_memory(const Pud *pud,
+                 size_t    *size_ret)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_RW, NULL);
+   PUD_SECTIONS_LOAD(pud, PUD_SECTIONS_ALL, NULL);
+
+   unsigned char *buf;
+   size_t size;
+
+   buf = _serialize(pud, &size);
+   if (buf && size_ret) *size_ret = size;
+   return buf;
+}
+
 void
 pud_version_set(Pud      *pud,
                 uint16_t  version)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
    pud->version = version;
+   pud->dirty |= PUD_SECTION_BIT(VER);
 }
 
 void
@@ -606,6 +1283,7 @@ pud_description_set(Pud        *pud,
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
    strncpy(pud->description, descr, 32);
    pud->description[31] = '\0';
+   pud->dirty |= PUD_SECTION_BIT(DESC);
 }
 
 const char *
@@ -620,6 +1298,71 @@ pud_tag_set(Pud      *pud,
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, VOID);
    pud->tag = tag;
+   pud->dirty |= PUD_SECTION_BIT(TYPE);
+}
+
+Pud_Bool
+pud_starting_resources_set(Pud        *pud,
+                           Pud_Player  player,
+                           uint16_t    gold,
+                           uint16_t    lumber,
+                           uint16_t    oil)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+
+   const unsigned int p = player;
+
+   if (p < 8)
+     {
+        pud->sgld.players[p] = gold;
+        pud->slbr.players[p] = lumber;
+        pud->soil.players[p] = oil;
+     }
+   else if (p < 15)
+     {
+        pud->sgld.unusable[p - 8] = gold;
+        pud->slbr.unusable[p - 8] = lumber;
+        pud->soil.unusable[p - 8] = oil;
+     }
+   else if (player == PUD_PLAYER_NEUTRAL)
+     {
+        pud->sgld.neutral = gold;
+        pud->slbr.neutral = lumber;
+        pud->soil.neutral = oil;
+     }
+   else
+     DIE_RETURN(PUD_FALSE, "Invalid player %i", player);
+
+   pud->dirty |= (PUD_SECTION_BIT(SGLD) | PUD_SECTION_BIT(SLBR) |
+                  PUD_SECTION_BIT(SOIL));
+   return PUD_TRUE;
+}
+
+/* Makes room for 'count' units. Arrays of the arena or of the memory map
+ * are never grown in place: they move to their own allocation. */
+static Pud_Bool
+_units_reserve(Pud          *pud,
+               unsigned int  count)
+{
+   unsigned int capacity;
+   void *ptr;
+
+   if ((count <= pud->units_capacity) &&
+       (!pud_arena_is(pud, pud->units)) && (!pud_borrowed_is(pud, pud->units)))
+     return PUD_TRUE;
+
+   /* Geometric growth: appending n units costs O(n) copies */
+   capacity = (pud->units_count < 8) ? 16 : pud->units_count * 2;
+   if ((capacity < count) || (pud->units_count > UINT32_MAX / 4)) capacity = count;
+
+   ptr = pud_array_realloc(pud, pud->units,
+                           pud->units_count * sizeof(Pud_Unit_Data),
+                           capacity * sizeof(Pud_Unit_Data));
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to alloc memory");
+   pud->units = ptr;
+   pud->units_capacity = capacity;
+
+   return PUD_TRUE;
 }
 
 int
@@ -632,10 +1375,6 @@ pud_unit_add(Pud        *pud,
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, -1);
 
-   size_t size;
-   int nb;
-   void *ptr;
-
    /* Override alter value for unspecified cases */
    if ((type != PUD_UNIT_GOLD_MINE) && (type != PUD_UNIT_OIL_PATCH))
      {
@@ -654,20 +1393,55 @@ pud_unit_add(Pud        *pud,
       .alter = alter
    };
 
-   if ((x > pud->map_w - 1) || (y > pud->map_h - 1))
-     DIE_RETURN(PUD_FALSE, "Invalid indexes [%i][%i]", x, y);
+   return pud_units_add_bulk(pud, &u, 1);
+}
 
-   /* TODO Optimise memory allocation because it is not great */
-   nb = pud->units_count + 1;
-   size = nb * sizeof(Pud_Unit_Data);
-   ptr = realloc(pud->units, size);
-   if (ptr == NULL) DIE_RETURN(-1, "Failed to alloc memory");
-   pud->units = ptr;
-   memcpy(&(pud->units[pud->units_count]), &u, sizeof(Pud_Unit_Data));
+int
+pud_units_add_bulk(Pud                 *pud,
+                   const Pud_Unit_Data *units,
+                   unsigned int         count)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, -1);
 
-   pud->units_count = nb;
+   const unsigned int types = sizeof(pud->unit_data) / sizeof(pud->unit_data[0]);
+   const Pud_Unit_Data *u;
+   unsigned int i, first;
+
+   if ((!units) && (count > 0)) DIE_RETURN(-1, "Invalid inputs");
 
-   return nb;
+   /* Nothing is added unless all the units are valid */
+   for (i = 0; i < count; i++)
+     {
+        u = &(units[i]);
+        if ((u->x >= pud->map_w) || (u->y >= pud->map_h))
+          DIE_RETURN(-1, "Invalid indexes [%i][%i] (unit %u)", u->x, u->y, i);
+        if (u->type >= types)
+          DIE_RETURN(-1, "Invalid unit type 0x%02x (unit %u)", u->type, i);
+     }
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(UNIT), -1);
+
+   if (count > (unsigned int)INT32_MAX - pud->units_count)
+     DIE_RETURN(-1, "Too many units");
+   if (!_units_reserve(pud, pud->units_count + count)) return -1;
+
+   first = pud->units_count;
+   if (count > 0)
+     memcpy(&(pud->units[first]), units, count * sizeof(Pud_Unit_Data));
+   pud->units_count += count;
+   pud->dirty |= PUD_SECTION_BIT(UNIT);
+
+   for (i = first; i < pud->units_count; i++)
+     {
+        u = &(pud->units[i]);
+        pud_units_index_add(pud, i);
+
+        /* The unit sizes are only known once UDTA is loaded (the minimap does) */
+        PUD_MINIMAP_DAMAGE(pud, u->x, u->y,
+                           (pud->unit_data[u->type].size_w) ? pud->unit_data[u->type].size_w : 1,
+                           (pud->unit_data[u->type].size_h) ? pud->unit_data[u->type].size_h : 1);
+     }
+
+   return (int)pud->units_count;
 }
 
 Pud_Bool
@@ -680,8 +1454,11 @@ pud_tile_set(Pud      *pud,
 
    if ((x > pud->map_w - 1) || (y > pud->map_h - 1))
      DIE_RETURN(PUD_FALSE, "Invalid indexes [%i][%i]", x, y);
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), PUD_FALSE);
 
    pud->tiles_map[(y * pud->map_w) + x] = tile;
+   pud->dirty |= PUD_SECTION_BIT(MTXM);
+   PUD_MINIMAP_DAMAGE(pud, x, y, 1, 1);
    return PUD_TRUE;
 }
 
@@ -694,10 +1471,197 @@ pud_tile_get(const Pud    *pud,
 
    if ((x > pud->map_w - 1) || (y > pud->map_h - 1))
      DIE_RETURN(0x0000, "Invalid indexes [%i][%i]", x, y);
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), 0x0000);
 
    return pud->tiles_map[(y * pud->map_w) + x];
 }
 
+/* Clips 'rect' (NULL for the whole map) to the map. Returns PUD_FALSE if
+ * nothing is left. */
+static Pud_Bool
+_rect_clip(const Pud      *pud,
+           const Pud_Rect *rect,
+           Pud_Rect       *clipped)
+{
+   if (!rect)
+     {
+        clipped->x = 0;
+        clipped->y = 0;
+        clipped->w = pud->map_w;
+        clipped->h = pud->map_h;
+     }
+   else
+     {
+        if ((rect->x >= pud->map_w) || (rect->y >= pud->map_h)) return PUD_FALSE;
+        *clipped = *rect;
+        if (clipped->w > pud->map_w - clipped->x) clipped->w = pud->map_w - clipped->x;
+        if (clipped->h > pud->map_h - clipped->y) clipped->h = pud->map_h - clipped->y;
+     }
+   return ((clipped->w != 0) && (clipped->h != 0));
+}
+
+Pud_Bool
+pud_tiles_fill_rect(Pud            *pud,
+                    const Pud_Rect *rect,
+                    uint16_t        tile)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+
+   Pud_Rect r;
+   uint16_t *row;
+   unsigned int j;
+
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), PUD_FALSE);
+   if (!_rect_clip(pud, rect, &r)) return PUD_TRUE;
+
+   /* The first row is filled, the others are copies of it */
+   row = &(pud->tiles_map[(r.y * pud->map_w) + r.x]);
+   _tiles_fill(row, tile, r.w);
+   for (j = 1; j < r.h; j++)
+     memcpy(row + (j * pud->map_w), row, r.w * sizeof(uint16_t));
+
+   pud->dirty |= PUD_SECTION_BIT(MTXM);
+   PUD_MINIMAP_DAMAGE(pud, r.x, r.y, r.w, r.h);
+   return PUD_TRUE;
+}
+
+Pud_Bool
+pud_tiles_blit(Pud            *pud,
+               int             x,
+               int             y,
+               const uint16_t *src,
+               unsigned int    src_w,
+               unsigned int    src_h,
+               size_t          src_stride)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+
+   long x0 = x, y0 = y, x1 = (long)x + src_w, y1 = (long)y + src_h;
+   uint16_t *dst;
+   long j, w, h;
+
+   if ((!src) || (src_stride < src_w)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), PUD_FALSE);
+
+   /* Clip the source by the map */
+   if (x0 < 0) x0 = 0;
+   if (y0 < 0) y0 = 0;
+   if (x1 > (long)pud->map_w) x1 = pud->map_w;
+   if (y1 > (long)pud->map_h) y1 = pud->map_h;
+   if ((x0 >= x1) || (y0 >= y1)) return PUD_TRUE;
+   w = x1 - x0;
+   h = y1 - y0;
+
+   src += ((y0 - y) * src_stride) + (x0 - x);
+   dst = &(pud->tiles_map[(y0 * pud->map_w) + x0]);
+
+   /* The source may be the map itself: copy rows in the safe order */
+   if (src < dst)
+     {
+        for (j = h - 1; j >= 0; j--)
+          memmove(dst + (j * pud->map_w), src + (j * src_stride), w * sizeof(uint16_t));
+     }
+   else
+     {
+        for (j = 0; j < h; j++)
+          memmove(dst + (j * pud->map_w), src + (j * src_stride), w * sizeof(uint16_t));
+     }
+
+   pud->dirty |= PUD_SECTION_BIT(MTXM);
+   PUD_MINIMAP_DAMAGE(pud, x0, y0, w, h);
+   return PUD_TRUE;
+}
+
+Pud_Bool
+pud_tiles_copy(Pud            *pud,
+               int             x,
+               int             y,
+               Pud            *src,
+               const Pud_Rect *area)
+{
+   PUD_SANITY_CHECK(src, PUD_OPEN_MODE_R, PUD_FALSE);
+
+   Pud_Rect r;
+
+   PUD_SECTIONS_LOAD(src, PUD_SECTION_BIT(MTXM), PUD_FALSE);
+   if (!_rect_clip(src, area, &r)) return PUD_TRUE;
+
+   /* The part of the area out of the source is not copied */
+   if (area)
+     {
+        x += (int)(r.x - area->x);
+        y += (int)(r.y - area->y);
+     }
+   return pud_tiles_blit(pud, x, y,
+                         &(src->tiles_map[(r.y * src->map_w) + r.x]),
+                         r.w, r.h, src->map_w);
+}
+
+Pud_Bool
+pud_tiles_replace(Pud            *pud,
+                  const Pud_Rect *rect,
+                  const uint16_t *lut,
+                  unsigned int    lut_size)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+
+   Pud_Rect r;
+   uint16_t *row;
+   unsigned int i, j;
+
+   if ((!lut) && (lut_size > 0)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), PUD_FALSE);
+   if (!_rect_clip(pud, rect, &r)) return PUD_TRUE;
+
+   /* Tiles beyond the table are kept */
+   for (j = 0; j < r.h; j++)
+     {
+        row = &(pud->tiles_map[((r.y + j) * pud->map_w) + r.x]);
+        for (i = 0; i < r.w; i++)
+          {
+             if (row[i] < lut_size)
+               row[i] = lut[row[i]];
+          }
+     }
+
+   pud->dirty |= PUD_SECTION_BIT(MTXM);
+   PUD_MINIMAP_DAMAGE(pud, r.x, r.y, r.w, r.h);
+   return PUD_TRUE;
+}
+
+Pud_Bool
+pud_tiles_randomize(Pud            *pud,
+                    const Pud_Rect *rect,
+                    uint64_t        seed)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_W, PUD_FALSE);
+
+   Pud_Random rng;
+   Pud_Rect r;
+   uint16_t *row;
+   unsigned int i, j;
+
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(MTXM), PUD_FALSE);
+   if (!_rect_clip(pud, rect, &r)) return PUD_TRUE;
+
+   /* Tiles are visited in order: the same seed gives the same map */
+   pud_random_seed(&rng, seed);
+   for (j = 0; j < r.h; j++)
+     {
+        row = &(pud->tiles_map[((r.y + j) * pud->map_w) + r.x]);
+        for (i = 0; i < r.w; i++)
+          {
+             /* Unknown tiles are kept */
+             if (pud_tile_variants_get(row[i]) != 0x0000)
+               row[i] = (row[i] & 0xfff0) | pud_random_variant_get(row[i], &rng);
+          }
+     }
+
+   pud->dirty |= PUD_SECTION_BIT(MTXM);
+   PUD_MINIMAP_DAMAGE(pud, r.x, r.y, r.w, r.h);
+   return PUD_TRUE;
+}
+
 Pud_Error
 pud_check(Pud                   *pud,
           Pud_Error_Description *err)
@@ -717,6 +1681,11 @@ pud_check(Pud                   *pud,
         ret = PUD_ERROR_NOT_INITIALIZED;
         goto end;
      }
+   if (!pud_sections_load(pud, PUD_SECTION_BIT(UNIT)))
+     {
+        ret = PUD_ERROR_UNDEFINED;
+        goto end;
+     }
 
    for (i = 0; i < pud->units_count; ++i)
      {
@@ -780,9 +1749,11 @@ pud_check(Pud                   *pud,
    /* If a player has no unit at all, it is controlled by nobody */
    for (i = 0; i < 8; i++)
      {
-        if (players_units[i] == 0)
+        if ((players_units[i] == 0) &&
+            (pud->owner.players[i] != PUD_OWNER_NOBODY))
           {
              pud->owner.players[i] = PUD_OWNER_NOBODY;
+             pud->dirty |= PUD_SECTION_BIT(OWNR);
           }
      }
 
@@ -5,346 +5,272 @@
  */
 
 #include "pud_private.h"
-#include <stdarg.h>
 
-#define BUF_SIZE 0xf
+/*
+ * Variants of each class of tiles, as a bitmask: bit N is set when the
+ * tile (class | N) exists. Solid tiles (0x00?0) are indexed by their
+ * second nibble, boundaries (0x0??0) by their two middle nibbles.
+ *
+ * This table comes from the code that tools/random_gen used to generate,
+ * which had been edited by hand to cover specific cases. Don't generate
+ * it again.
+ */
+static const uint16_t _variants[0xa0] =
+{
+   [0x01] = 0x00ee,
+   [0x02] = 0x00ef,
+   [0x03] = 0x0ff7,
+   [0x04] = 0x0ff7,
+   [0x05] = 0xfff7,
+   [0x06] = 0xfff7,
+   [0x07] = 0x0007,
+   [0x08] = 0x000f,
+   [0x09] = 0x0001,
+   [0x0a] = 0x0001,
+   [0x0b] = 0x0001,
+   [0x0c] = 0x0001,
+   [0x10] = 0x0003,
+   [0x11] = 0x0003,
+   [0x12] = 0x0007,
+   [0x13] = 0x0003,
+   [0x14] = 0x0007,
+   [0x15] = 0x0003,
+   [0x16] = 0x0003,
+   [0x17] = 0x0003,
+   [0x18] = 0x0003,
+   [0x19] = 0x0007,
+   [0x1a] = 0x0003,
+   [0x1b] = 0x0007,
+   [0x1c] = 0x0003,
+   [0x1d] = 0x0003,
+   [0x20] = 0x0003,
+   [0x21] = 0x0003,
+   [0x22] = 0x0007,
+   [0x23] = 0x0003,
+   [0x24] = 0x0007,
+   [0x25] = 0x0003,
+   [0x26] = 0x0003,
+   [0x27] = 0x0003,
+   [0x28] = 0x0003,
+   [0x29] = 0x0007,
+   [0x2a] = 0x0003,
+   [0x2b] = 0x0007,
+   [0x2c] = 0x0003,
+   [0x2d] = 0x0003,
+   [0x30] = 0x0003,
+   [0x31] = 0x0003,
+   [0x32] = 0x0007,
+   [0x33] = 0x0003,
+   [0x34] = 0x0007,
+   [0x35] = 0x0003,
+   [0x36] = 0x0003,
+   [0x37] = 0x0003,
+   [0x38] = 0x0003,
+   [0x39] = 0x0007,
+   [0x3a] = 0x0003,
+   [0x3b] = 0x0007,
+   [0x3c] = 0x0003,
+   [0x3d] = 0x0003,
+   [0x40] = 0x0003,
+   [0x41] = 0x0003,
+   [0x42] = 0x0003,
+   [0x43] = 0x0003,
+   [0x44] = 0x0003,
+   [0x45] = 0x0003,
+   [0x46] = 0x0001,
+   [0x47] = 0x0003,
+   [0x48] = 0x0003,
+   [0x49] = 0x0003,
+   [0x4a] = 0x0001,
+   [0x4b] = 0x0003,
+   [0x4c] = 0x0001,
+   [0x4d] = 0x0001,
+   [0x50] = 0x0003,
+   [0x51] = 0x0003,
+   [0x52] = 0x0007,
+   [0x53] = 0x0003,
+   [0x54] = 0x0007,
+   [0x55] = 0x0003,
+   [0x56] = 0x0003,
+   [0x57] = 0x0003,
+   [0x58] = 0x0003,
+   [0x59] = 0x0007,
+   [0x5a] = 0x0003,
+   [0x5b] = 0x0007,
+   [0x5c] = 0x0003,
+   [0x5d] = 0x0003,
+   [0x60] = 0x0003,
+   [0x61] = 0x0003,
+   [0x62] = 0x0007,
+   [0x63] = 0x0003,
+   [0x64] = 0x0007,
+   [0x65] = 0x0003,
+   [0x66] = 0x0003,
+   [0x67] = 0x0003,
+   [0x68] = 0x0003,
+   [0x69] = 0x0007,
+   [0x6a] = 0x0003,
+   [0x6b] = 0x0007,
+   [0x6c] = 0x0003,
+   [0x6d] = 0x0003,
+   [0x70] = 0x0003,
+   [0x71] = 0x0003,
+   [0x72] = 0x0003,
+   [0x73] = 0x0003,
+   [0x74] = 0x0003,
+   [0x75] = 0x0003,
+   [0x76] = 0x0003,
+   [0x77] = 0x0003,
+   [0x78] = 0x0003,
+   [0x79] = 0x0003,
+   [0x7a] = 0x0003,
+   [0x7b] = 0x0003,
+   [0x7c] = 0x0003,
+   [0x7d] = 0x0003,
+   [0x80] = 0x0001,
+   [0x81] = 0x0001,
+   [0x82] = 0x0001,
+   [0x83] = 0x0001,
+   [0x84] = 0x0003,
+   [0x85] = 0x0001,
+   [0x86] = 0x0001,
+   [0x87] = 0x0001,
+   [0x88] = 0x0001,
+   [0x89] = 0x0003,
+   [0x8a] = 0x0001,
+   [0x8b] = 0x0001,
+   [0x8c] = 0x0001,
+   [0x8d] = 0x0001,
+   [0x90] = 0x0001,
+   [0x91] = 0x0001,
+   [0x92] = 0x0001,
+   [0x93] = 0x0001,
+   [0x94] = 0x0003,
+   [0x95] = 0x0001,
+   [0x96] = 0x0001,
+   [0x97] = 0x0001,
+   [0x98] = 0x0001,
+   [0x99] = 0x0003,
+   [0x9a] = 0x0001,
+   [0x9b] = 0x0001,
+   [0x9c] = 0x0001,
+};
 
-static unsigned int
-_rands_gen(uint8_t buf[BUF_SIZE], unsigned int count, ...)
+uint16_t
+pud_tile_variants_get(uint16_t tile)
 {
-   va_list args;
-   uint8_t arg;
-   unsigned int k = 0;
+   unsigned int idx;
 
-   va_start(args, count);
-   for (k = 0; k < count; ++k)
+   if ((tile & 0xff00) == 0x0000) /* Solid */
+     idx = (tile & 0x00f0) >> 4;
+   else /* Boundry */
      {
-        arg = (uint8_t)va_arg(args, int);
-        buf[k] = arg;
+        idx = (tile & 0x0ff0) >> 4;
+        if (idx < 0x10) return 0x0000;
      }
-   va_end(args);
 
-   return k;
+   return (idx < sizeof(_variants) / sizeof(_variants[0])) ? _variants[idx] : 0x0000;
 }
 
-uint8_t
-pud_random_get(uint16_t tile)
+/* Returns the n-th variant set in 'variants' */
+static inline uint8_t
+_variant_nth(uint16_t     variants,
+             unsigned int n)
 {
-   uint8_t rands[BUF_SIZE];
-   unsigned int count = 0;
+   unsigned int k;
 
-#define GEN(cnt, ...) count = _rands_gen(rands, cnt, __VA_ARGS__)
+   for (k = 0; k < 16; k++)
+     {
+        if ((variants & (1 << k)) && (n-- == 0))
+          break;
+     }
+   return (uint8_t)k;
+}
 
-   /* =====================================================
-    *
-    * The code below has been generated by tools/random_gen
-    *
-    * ==================== BIG FAT WARNING ================
-    *
-    * DON'T RELY ON THE GENERATOR ANYMORE!!! THE CODE HAS
-    * BEEN EDITED BY HAND TO COVER SPECIFIC CASES THE
-    * GENERATOR DOES NOT HANDLE (CUMBERSOME TO WRITE)
-    *
-    * ===================================================== */
+static inline uint64_t
+_rotl(uint64_t     x,
+      unsigned int k)
+{
+   return (x << k) | (x >> (64 - k));
+}
 
-   if ((tile & 0xff00) == 0x0000) /* Solid */
+void
+pud_random_seed(Pud_Random *rng,
+                uint64_t    seed)
+{
+   unsigned int i;
+   uint64_t z;
+
+   /* SplitMix64 expands the seed: the state is never all zeros */
+   for (i = 0; i < 4; i++)
      {
-        switch (tile & 0x00f0)
-          {
-           case 0x0010:
-              GEN(6, 0x1, 0x2, 0x3, 0x5, 0x6, 0x7); break;
-           case 0x0020:
-              GEN(7, 0x0, 0x1, 0x2, 0x3, 0x5, 0x6, 0x7); break;
-           case 0x0030:
-              GEN(11, 0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb); break;
-           case 0x0040:
-              GEN(11, 0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb); break;
-           case 0x0050:
-              GEN(15, 0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf); break;
-           case 0x0060:
-              GEN(15, 0x0, 0x1, 0x2, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf); break;
-           case 0x0070:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0080:
-              GEN(4, 0x0, 0x1, 0x2, 0x3); break;
-           case 0x0090:
-              GEN(1, 0x0); break;
-           case 0x00a0:
-              GEN(1, 0x0); break;
-           case 0x00b0:
-              GEN(1, 0x0); break;
-           case 0x00c0:
-              GEN(1, 0x0); break;
-           default:
-              fprintf(stderr, "*** Invalid tile 0x%04x\n", tile);
-              return 0x0000;
-          }
+        seed += 0x9e3779b97f4a7c15ULL;
+        z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        rng->s[i] = z ^ (z >> 31);
      }
-   else /* Boundry */
+}
+
+uint64_t
+pud_random_next(Pud_Random *rng)
+{
+   /* xoshiro256** */
+   const uint64_t result = _rotl(rng->s[1] * 5, 7) * 9;
+   const uint64_t t = rng->s[1] << 17;
+
+   rng->s[2] ^= rng->s[0];
+   rng->s[3] ^= rng->s[1];
+   rng->s[1] ^= rng->s[2];
+   rng->s[0] ^= rng->s[3];
+   rng->s[2] ^= t;
+   rng->s[3] = _rotl(rng->s[3], 45);
+
+   return result;
+}
+
+uint32_t
+pud_random_uniform(Pud_Random *rng,
+                   uint32_t    bound)
+{
+   uint64_t m;
+   uint32_t threshold;
+
+   if (bound <= 1) return 0;
+
+   /* Multiply-shift, with rejection of the biased values */
+   m = (pud_random_next(rng) >> 32) * bound;
+   if ((uint32_t)m < bound)
      {
-        switch (tile & 0x0ff0)
-          {
-           case 0x0100:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0110:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0120:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0130:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0140:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0150:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0160:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0170:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0180:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0190:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x01a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x01b0:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x01c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x01d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0200:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0210:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0220:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0230:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0240:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0250:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0260:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0270:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0280:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0290:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x02a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x02b0:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x02c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x02d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0300:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0310:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0320:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0330:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0340:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0350:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0360:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0370:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0380:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0390:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x03a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x03b0:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x03c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x03d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0400:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0410:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0420:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0430:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0440:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0450:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0460:
-              GEN(1, 0x0); break;
-           case 0x0470:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0480:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0490:
-              GEN(2, 0x0, 0x1); break;
-           case 0x04a0:
-              GEN(1, 0x0); break;
-           case 0x04b0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x04c0:
-              GEN(1, 0x0); break;
-           case 0x04d0:
-              GEN(1, 0x0); break;
-           case 0x0500:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0510:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0520:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0530:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0540:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0550:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0560:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0570:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0580:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0590:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x05a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x05b0:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x05c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x05d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0600:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0610:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0620:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0630:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0640:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x0650:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0660:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0670:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0680:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0690:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x06a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x06b0:
-              GEN(3, 0x0, 0x1, 0x2); break;
-           case 0x06c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x06d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0700:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0710:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0720:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0730:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0740:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0750:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0760:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0770:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0780:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0790:
-              GEN(2, 0x0, 0x1); break;
-           case 0x07a0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x07b0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x07c0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x07d0:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0800:
-              GEN(1, 0x0); break;
-           case 0x0810:
-              GEN(1, 0x0); break;
-           case 0x0820:
-              GEN(1, 0x0); break;
-           case 0x0830:
-              GEN(1, 0x0); break;
-           case 0x0840:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0850:
-              GEN(1, 0x0); break;
-           case 0x0860:
-              GEN(1, 0x0); break;
-           case 0x0870:
-              GEN(1, 0x0); break;
-           case 0x0880:
-              GEN(1, 0x0); break;
-           case 0x0890:
-              GEN(2, 0x0, 0x1); break;
-           case 0x08a0:
-              GEN(1, 0x0); break;
-           case 0x08b0:
-              GEN(1, 0x0); break;
-           case 0x08c0:
-              GEN(1, 0x0); break;
-           case 0x08d0:
-              GEN(1, 0x0); break;
-           case 0x0900:
-              GEN(1, 0x0); break;
-           case 0x0910:
-              GEN(1, 0x0); break;
-           case 0x0920:
-              GEN(1, 0x0); break;
-           case 0x0930:
-              GEN(1, 0x0); break;
-           case 0x0940:
-              GEN(2, 0x0, 0x1); break;
-           case 0x0950:
-              GEN(1, 0x0); break;
-           case 0x0960:
-              GEN(1, 0x0); break;
-           case 0x0970:
-              GEN(1, 0x0); break;
-           case 0x0980:
-              GEN(1, 0x0); break;
-           case 0x0990:
-              GEN(2, 0x0, 0x1); break;
-           case 0x09a0:
-              GEN(1, 0x0); break;
-           case 0x09b0:
-              GEN(1, 0x0); break;
-           case 0x09c0:
-              GEN(1, 0x0); break;
-           default:
-              fprintf(stderr, "*** Invalid tile 0x%04x\n", tile);
-              return 0x0000;
-          }
+        threshold = (uint32_t)(-bound) % bound;
+        while ((uint32_t)m < threshold)
+          m = (pud_random_next(rng) >> 32) * bound;
      }
+   return (uint32_t)(m >> 32);
+}
 
-   /*
-    * End of generated code
-    */
+uint8_t
+pud_random_variant_get(uint16_t    tile,
+                       Pud_Random *rng)
+{
+   const uint16_t variants = pud_tile_variants_get(tile);
+
+   if (variants == 0x0000)
+     DIE_RETURN(0x00, "Invalid tile 0x%04x", tile);
+
+   return _variant_nth(variants,
+                       pud_random_uniform(rng, __builtin_popcount(variants)));
+}
+
+uint8_t
+pud_random_get(uint16_t tile)
+{
+   const uint16_t variants = pud_tile_variants_get(tile);
 
-#undef GEN
+   if (variants == 0x0000)
+     DIE_RETURN(0x00, "Invalid tile 0x%04x", tile);
 
-   return (count == 0) ? rands[0] : rands[rand() % count];
+   /* Process-wide rand(): use pud_random_variant_get() to reproduce maps */
+   return _variant_nth(variants,
+                       (unsigned int)rand() % __builtin_popcount(variants));
 }
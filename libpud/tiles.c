@@ -8,1598 +8,867 @@
 #include "pud_private.h"
 #include "pud.h"
 
-Pud_Color
-pud_tile_to_color(Pud_Era   era,
-                  uint16_t  tile)
+#define UNKNOWN_COLOR { 0xff, 0x00, 0xff, 0xff } /* Flashy to be seen (debug) */
+
+#define PALETTE_SIZE(palette_) (sizeof(palette_) / sizeof(palette_[0]))
+
+/* =====================================================
+ *
+ * The tables below have been generated by tools/tilemap
+ *
+ * ===================================================== */
+
+static const Pud_Color _forest_palette[] =
+{
+   UNKNOWN_COLOR,
+   { 0x04, 0x38, 0x75, 0xff },
+   { 0x04, 0x34, 0x71, 0xff },
+   { 0x6d, 0x41, 0x00, 0xff },
+   { 0x75, 0x45, 0x04, 0xff },
+   { 0x51, 0x30, 0x00, 0xff },
+   { 0x61, 0x38, 0x00, 0xff },
+   { 0x28, 0x55, 0x0c, 0xff },
+   { 0x24, 0x49, 0x04, 0xff },
+   { 0x2c, 0x5d, 0x10, 0xff },
+   { 0x41, 0x2c, 0x00, 0xff },
+   { 0x49, 0x49, 0x49, 0xff },
+   { 0x00, 0x4d, 0x00, 0xff },
+   { 0x18, 0x18, 0x18, 0xff },
+   { 0x3c, 0x3c, 0x3c, 0xff },
+   { 0x51, 0x51, 0x51, 0xff },
+   { 0x75, 0x75, 0x75, 0xff },
+   { 0x69, 0x69, 0x69, 0xff },
+   { 0x96, 0x96, 0x96, 0xff },
+   { 0x8a, 0x8a, 0x8a, 0xff },
+   { 0x8a, 0x61, 0x18, 0xff },
+   { 0x00, 0x20, 0x55, 0xff },
+   { 0x00, 0x30, 0x69, 0xff },
+   { 0x00, 0x28, 0x5d, 0xff },
+   { 0x59, 0x34, 0x10, 0xff },
+   { 0x7d, 0x7d, 0x7d, 0xff },
+   { 0x30, 0x30, 0x30, 0xff },
+   { 0x4d, 0x6d, 0x1c, 0xff },
+   { 0x3c, 0x65, 0x14, 0xff },
+   { 0x00, 0x2c, 0x00, 0xff },
+   { 0x14, 0x34, 0x00, 0xff },
+   { 0x24, 0x24, 0x24, 0xff },
+   { 0x5d, 0x5d, 0x5d, 0xff },
+   { 0xa2, 0x86, 0x4d, 0xff },
+};
+
+static const uint8_t _forest_tiles[PUD_TILES_TABLE_SIZE] =
+{
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  5,  3,  3,  3,  3,  6,  3,  3,  0,  0,  0,  0,
+    6,  6,  3,  0,  6,  6,  6,  6,  6,  5,  6,  6,  0,  0,  0,  0,
+    7,  7,  7,  0,  8,  7,  8,  9,  8, 10,  8,  7,  8,  7,  8,  7,
+    8,  8,  8,  0,  8, 11,  8,  8,  8,  8,  8, 11,  8, 11,  8, 11,
+   12, 12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 11, 14, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15,  0, 11,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0,  7,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0, 18,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0, 20,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  2,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2, 22, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   21, 22, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  6,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  6,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   26, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 26,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  6, 28,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  9,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15,  0, 16,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15,  0, 16,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15,  0, 16,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 19,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19, 19,  0, 31, 26,  0, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 19,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 14,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 19,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 19,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19, 19,  0, 16, 19,  0, 32, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0, 15,  0, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0,  7,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0,  7,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0,  7,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 33,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 17,  0, 33, 11,  0, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 33,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 11,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   32,  0, 14,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   32,  0, 14,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   32, 32,  0, 14, 10,  0, 32, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+   32,  0, 14,  0, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0, 20,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0, 20,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0, 20,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static const Pud_Color _winter_palette[] =
+{
+   UNKNOWN_COLOR,
+   { 0x04, 0x38, 0x75, 0xff },
+   { 0x61, 0x9a, 0xcb, 0xff },
+   { 0x04, 0x34, 0x71, 0xff },
+   { 0x18, 0x55, 0x8a, 0xff },
+   { 0x69, 0x6d, 0x86, 0xff },
+   { 0x14, 0x4d, 0x8e, 0xff },
+   { 0x8e, 0x8e, 0x9e, 0xff },
+   { 0x96, 0x96, 0xa2, 0xff },
+   { 0x86, 0x86, 0x9a, 0xff },
+   { 0x20, 0x59, 0x65, 0xff },
+   { 0x4d, 0x55, 0x71, 0xff },
+   { 0xa2, 0xa2, 0xa6, 0xff },
+   { 0x49, 0x28, 0x20, 0xff },
+   { 0x41, 0x49, 0x69, 0xff },
+   { 0x71, 0x75, 0x8e, 0xff },
+   { 0x59, 0x61, 0x7d, 0xff },
+   { 0x14, 0x49, 0x49, 0xff },
+   { 0x8a, 0x61, 0x4d, 0xff },
+   { 0x55, 0x7d, 0xb2, 0xff },
+   { 0x38, 0x65, 0x9a, 0xff },
+   { 0x2c, 0x5d, 0x96, 0xff },
+   { 0x7d, 0x55, 0x49, 0xff },
+   { 0x75, 0x49, 0x3c, 0xff },
+   { 0x61, 0x65, 0x82, 0xff },
+   { 0x3c, 0x24, 0x20, 0xff },
+   { 0x08, 0x45, 0x79, 0xff },
+   { 0x00, 0x30, 0x69, 0xff },
+   { 0x04, 0x28, 0x08, 0xff },
+   { 0x0c, 0x30, 0x0c, 0xff },
+   { 0x00, 0x28, 0x5d, 0xff },
+   { 0x30, 0x49, 0x59, 0xff },
+   { 0xaa, 0x86, 0x4d, 0xff },
+};
+
+static const uint8_t _winter_tiles[PUD_TILES_TABLE_SIZE] =
+{
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  1,  0,  2,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  3,  3,  0,  2,  3,  3,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  4,  5,  4,  4,  4,  4,  4,  4,  0,  0,  0,  0,
+    6,  6,  6,  0,  6,  5,  6,  6,  6,  6,  6,  6,  0,  0,  0,  0,
+    7,  8,  7,  0,  7,  7,  7,  8,  8,  7,  7,  7,  7,  7,  7,  8,
+    9,  7,  9,  0,  9,  9,  9,  7,  7,  9,  9,  9,  9,  9,  7,  7,
+   10, 10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12, 13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  0, 14,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0,  7,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  0,  8,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  3,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4, 20,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  4,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   21, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  4, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4, 21,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  6,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4, 26,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28, 28,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 28,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  0, 15,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  0, 15,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  0, 15,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0,  9,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0, 30, 30,  0, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0,  9,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0, 31,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0,  9,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0,  9,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0, 15,  9,  0, 16, 14,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  0, 11,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  0,  8,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  0,  8,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  0,  8,  0, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0,  5,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0,  7,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0,  7,  0, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0, 32,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  5,  0, 32, 14,  0, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0, 32,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  0, 14,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 17,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 17,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 16,  0, 25, 17,  0, 16, 14,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 17,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 18,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 18,  0, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static const Pud_Color _wasteland_palette[] =
+{
+   UNKNOWN_COLOR,
+   { 0x0c, 0x20, 0x2c, 0xff },
+   { 0x10, 0x20, 0x2c, 0xff },
+   { 0x4d, 0x28, 0x0c, 0xff },
+   { 0x45, 0x24, 0x08, 0xff },
+   { 0x41, 0x20, 0x08, 0xff },
+   { 0x3c, 0x1c, 0x08, 0xff },
+   { 0x79, 0x38, 0x04, 0xff },
+   { 0x82, 0x41, 0x04, 0xff },
+   { 0xa6, 0x59, 0x14, 0xff },
+   { 0x8e, 0x49, 0x04, 0xff },
+   { 0x71, 0x30, 0x04, 0xff },
+   { 0x51, 0x1c, 0x08, 0xff },
+   { 0x1c, 0x24, 0x00, 0xff },
+   { 0x04, 0x10, 0x00, 0xff },
+   { 0x18, 0x10, 0x10, 0xff },
+   { 0x49, 0x3c, 0x38, 0xff },
+   { 0x41, 0x34, 0x30, 0xff },
+   { 0x38, 0x28, 0x28, 0xff },
+   { 0x5d, 0x51, 0x4d, 0xff },
+   { 0x55, 0x45, 0x45, 0xff },
+   { 0x8e, 0x86, 0x82, 0xff },
+   { 0x79, 0x6d, 0x69, 0xff },
+   { 0x71, 0x65, 0x61, 0xff },
+   { 0x24, 0x18, 0x18, 0xff },
+   { 0x2c, 0x10, 0x04, 0xff },
+   { 0x0c, 0x28, 0x34, 0xff },
+   { 0x2c, 0x20, 0x20, 0xff },
+   { 0x45, 0x18, 0x08, 0xff },
+   { 0x65, 0x28, 0x04, 0xff },
+   { 0x38, 0x14, 0x08, 0xff },
+   { 0x08, 0x18, 0x00, 0xff },
+   { 0x34, 0x30, 0x00, 0xff },
+   { 0x59, 0x34, 0x18, 0xff },
+};
+
+static const uint8_t _wasteland_tiles[PUD_TILES_TABLE_SIZE] =
 {
-   switch (era)
-     {
-      case PUD_ERA_FOREST:
-         switch (tile)
-           {
-            case 0x0010: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0011: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0012: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0013: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0020: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0021: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0022: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0023: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0030: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0031: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0032: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0034: return color_make(0x51, 0x30, 0x00, 0xff);
-            case 0x0035: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0036: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0037: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0038: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0039: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x003a: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x003b: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0040: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0041: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0042: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0044: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0045: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0046: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0047: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0048: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0049: return color_make(0x51, 0x30, 0x00, 0xff);
-            case 0x004a: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x004b: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0050: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0051: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0052: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0054: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0055: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0056: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0057: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0058: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0059: return color_make(0x41, 0x2c, 0x00, 0xff);
-            case 0x005a: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x005b: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x005c: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x005d: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x005e: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x005f: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0060: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0061: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0062: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0064: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0065: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0066: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0067: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0068: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0069: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x006a: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x006b: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x006c: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x006d: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x006e: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x006f: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0070: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0071: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0072: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0080: return color_make(0x18, 0x18, 0x18, 0xff);
-            case 0x0081: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0082: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0083: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0090: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0092: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0094: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x00a0: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x00a2: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x00a4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x00b0: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x00b2: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x00b4: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x00c0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x00c2: return color_make(0x8a, 0x61, 0x18, 0xff);
-            case 0x00c4: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0100: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0101: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0110: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0111: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0120: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0121: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0122: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0130: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0131: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0140: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0141: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0142: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0150: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0151: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0160: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0161: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0170: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0171: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0180: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0181: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0190: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0191: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0192: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01a0: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01a1: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01b0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01b1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01b2: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01c0: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01c1: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01d0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01d1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0200: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0201: return color_make(0x00, 0x20, 0x55, 0xff);
-            case 0x0210: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0211: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0220: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0221: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x0222: return color_make(0x00, 0x28, 0x5d, 0xff);
-            case 0x0230: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0231: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0240: return color_make(0x00, 0x20, 0x55, 0xff);
-            case 0x0241: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x0242: return color_make(0x00, 0x20, 0x55, 0xff);
-            case 0x0250: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0251: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0260: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0261: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0270: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0271: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0280: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x0281: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x0290: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0291: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0292: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x02a0: return color_make(0x59, 0x34, 0x10, 0xff);
-            case 0x02a1: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x02b0: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x02b1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x02b2: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x02c0: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x02c1: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x02d0: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x02d1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0300: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0301: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0310: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0311: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0320: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0321: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0322: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0330: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0331: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0340: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0341: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0342: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0350: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0351: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0360: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0361: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0370: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0371: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0380: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0381: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0390: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0391: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0392: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x03a0: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x03a1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x03b0: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x03b1: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x03b2: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x03c0: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x03c1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x03d0: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x03d1: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0400: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0401: return color_make(0x7d, 0x7d, 0x7d, 0xff);
-            case 0x0410: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0411: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0420: return color_make(0x7d, 0x7d, 0x7d, 0xff);
-            case 0x0421: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0430: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0431: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0440: return color_make(0x30, 0x30, 0x30, 0xff);
-            case 0x0441: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0450: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0451: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0460: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0470: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0471: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0480: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0481: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0490: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0491: return color_make(0x30, 0x30, 0x30, 0xff);
-            case 0x04a0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x04b0: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x04b1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x04c0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x04d0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0500: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0501: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0510: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0511: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0520: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0521: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0522: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0530: return color_make(0x4d, 0x6d, 0x1c, 0xff);
-            case 0x0531: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0540: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0541: return color_make(0x61, 0x38, 0x00, 0xff);
-            case 0x0542: return color_make(0x3c, 0x65, 0x14, 0xff);
-            case 0x0550: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0551: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0560: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0561: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0570: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0571: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0580: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x0581: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x0590: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0591: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0592: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x05a0: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x05a1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x05b0: return color_make(0x51, 0x30, 0x00, 0xff);
-            case 0x05b1: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x05b2: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x05c0: return color_make(0x75, 0x45, 0x04, 0xff);
-            case 0x05c1: return color_make(0x6d, 0x41, 0x00, 0xff);
-            case 0x05d0: return color_make(0x51, 0x30, 0x00, 0xff);
-            case 0x05d1: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0600: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0601: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0610: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0611: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0620: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0621: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0622: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0630: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0631: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0640: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0641: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0642: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0650: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0651: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0660: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0661: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0670: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0671: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0680: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0681: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0690: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0691: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0692: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x06a0: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06a1: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06b0: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06b1: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06b2: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x06c0: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06c1: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x06d0: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x06d1: return color_make(0x2c, 0x5d, 0x10, 0xff);
-            case 0x0700: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0701: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0710: return color_make(0x14, 0x34, 0x00, 0xff);
-            case 0x0711: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0720: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0721: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0730: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0731: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0740: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0741: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0750: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0751: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0760: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0761: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x0770: return color_make(0x24, 0x49, 0x04, 0xff);
-            case 0x0771: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0780: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0781: return color_make(0x00, 0x2c, 0x00, 0xff);
-            case 0x0790: return color_make(0x14, 0x34, 0x00, 0xff);
-            case 0x0791: return color_make(0x14, 0x34, 0x00, 0xff);
-            case 0x07a0: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x07a1: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x07b0: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x07b1: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x07c0: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x07c1: return color_make(0x00, 0x4d, 0x00, 0xff);
-            case 0x07d0: return color_make(0x41, 0x2c, 0x00, 0xff);
-            case 0x07d1: return color_make(0x41, 0x2c, 0x00, 0xff);
-            case 0x0800: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0802: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0804: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0810: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0812: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0814: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0820: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x0822: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0824: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0830: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0832: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0834: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0840: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0841: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0843: return color_make(0x24, 0x24, 0x24, 0xff);
-            case 0x0844: return color_make(0x30, 0x30, 0x30, 0xff);
-            case 0x0846: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0847: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0850: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0852: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0854: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0860: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0862: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0864: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0870: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0872: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0874: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0880: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0882: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0884: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0890: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0891: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0893: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0894: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x0896: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0897: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x08a0: return color_make(0x8a, 0x8a, 0x8a, 0xff);
-            case 0x08a2: return color_make(0x51, 0x51, 0x51, 0xff);
-            case 0x08a4: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x08b0: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08b2: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08b4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x08c0: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08c2: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08c4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x08d0: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08d2: return color_make(0x96, 0x96, 0x96, 0xff);
-            case 0x08d4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0900: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0902: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0904: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0910: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0912: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0914: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0920: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0922: return color_make(0x28, 0x55, 0x0c, 0xff);
-            case 0x0924: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0930: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0932: return color_make(0xa2, 0x86, 0x4d, 0xff);
-            case 0x0934: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0940: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0941: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0943: return color_make(0xa2, 0x86, 0x4d, 0xff);
-            case 0x0944: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0946: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0947: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0950: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0952: return color_make(0xa2, 0x86, 0x4d, 0xff);
-            case 0x0954: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0960: return color_make(0x69, 0x69, 0x69, 0xff);
-            case 0x0962: return color_make(0x49, 0x49, 0x49, 0xff);
-            case 0x0964: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0970: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0972: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0974: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0980: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0982: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0984: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x0990: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0991: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0993: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x0994: return color_make(0x41, 0x2c, 0x00, 0xff);
-            case 0x0996: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x0997: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x09a0: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x09a2: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x09a4: return color_make(0x5d, 0x5d, 0x5d, 0xff);
-            case 0x09b0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x09b2: return color_make(0x8a, 0x61, 0x18, 0xff);
-            case 0x09b4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x09c0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x09c2: return color_make(0x8a, 0x61, 0x18, 0xff);
-            case 0x09c4: return color_make(0x75, 0x75, 0x75, 0xff);
-            case 0x09d0: return color_make(0x3c, 0x3c, 0x3c, 0xff);
-            case 0x09d2: return color_make(0x8a, 0x61, 0x18, 0xff);
-            case 0x09d4: return color_make(0x75, 0x75, 0x75, 0xff);
-            default:     break;
-           }
-         break;
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  1,  0,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  2,  0,  2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  3,  4,  3,  3,  4,  3,  4,  3,  0,  0,  0,  0,
+    4,  5,  4,  0,  6,  5,  4,  6,  6,  5,  5,  4,  0,  0,  0,  0,
+    7,  8,  8,  0,  7,  8,  8,  9,  7,  8,  8, 10,  8,  8,  8,  8,
+   11,  7,  7,  0, 11,  7,  7, 11, 12,  7,  7,  8,  7,  7, 12, 11,
+   13, 13, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15, 16, 17, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0, 18,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  7,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   21,  0, 22,  0, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  0,  8,  0, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  1,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 26,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    5,  3,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  5,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  5,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 28,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   10,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7, 11,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   29, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   31, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   14, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   32, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 19,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 19,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17,  0, 19,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 23,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23, 23,  0, 15, 24,  0, 19, 19,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 23,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 27,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 23,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 23,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23, 23,  0, 19, 23,  0, 16, 19,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 17,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22,  0, 22,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22,  0, 22,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   22,  0, 22,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  7,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  7,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  7,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  9,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20, 20,  0,  9, 18,  0, 19, 19,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0,  9,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 18,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 27,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 27,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 16,  0, 27, 33,  0, 16, 19,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 27,  0, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27,  0,  8,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27,  0,  8,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27,  0,  8,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
 
-      case PUD_ERA_WINTER:
-         switch (tile)
-           {
-            case 0x0010: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0011: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0012: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0013: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0015: return color_make(0x61, 0x9a, 0xcb, 0xff);
-            case 0x0016: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0017: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0020: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0021: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0022: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0023: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0025: return color_make(0x61, 0x9a, 0xcb, 0xff);
-            case 0x0026: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0027: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0030: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0031: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0032: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0034: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0035: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0036: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0037: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0038: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0039: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x003a: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x003b: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0040: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0041: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0042: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0044: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0045: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0046: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0047: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0048: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0049: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x004a: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x004b: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0050: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0051: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0052: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0054: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0055: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0056: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0057: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0058: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0059: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005a: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005b: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005c: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005d: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005e: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x005f: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0060: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0061: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0062: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0064: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0065: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0066: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0067: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0068: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0069: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x006a: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x006b: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x006c: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x006d: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x006e: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x006f: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0070: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0071: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0072: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0080: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x0081: return color_make(0xa2, 0xa2, 0xa6, 0xff);
-            case 0x0082: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x0083: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x0090: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x0092: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x0094: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x00a0: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x00a2: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x00a4: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x00b0: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x00b2: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x00b4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x00c0: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x00c2: return color_make(0x8a, 0x61, 0x4d, 0xff);
-            case 0x00c4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0100: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0101: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0110: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0111: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0120: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0121: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0122: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0130: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0131: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0140: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0141: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0142: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0150: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0151: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0160: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0161: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0170: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0171: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0180: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0181: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0190: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0191: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0192: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01a0: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01a1: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01b0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01b1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01b2: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01c0: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01c1: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x01d0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x01d1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0200: return color_make(0x04, 0x34, 0x71, 0xff);
-            case 0x0201: return color_make(0x55, 0x7d, 0xb2, 0xff);
-            case 0x0210: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0211: return color_make(0x38, 0x65, 0x9a, 0xff);
-            case 0x0220: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0221: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0222: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0230: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0231: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0240: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0241: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0242: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0250: return color_make(0x2c, 0x5d, 0x96, 0xff);
-            case 0x0251: return color_make(0x2c, 0x5d, 0x96, 0xff);
-            case 0x0260: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0261: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0270: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0271: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0280: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0281: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x0290: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0291: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0292: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x02a0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x02a1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x02b0: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x02b1: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x02b2: return color_make(0x2c, 0x5d, 0x96, 0xff);
-            case 0x02c0: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x02c1: return color_make(0x04, 0x38, 0x75, 0xff);
-            case 0x02d0: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x02d1: return color_make(0x2c, 0x5d, 0x96, 0xff);
-            case 0x0300: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0301: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0310: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0311: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0320: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0321: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0322: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0330: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0331: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0340: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0341: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0342: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0350: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0351: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0360: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0361: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0370: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0371: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0380: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0381: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0390: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0391: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0392: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03a0: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x03a1: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x03b0: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03b1: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03b2: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03c0: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03c1: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x03d0: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x03d1: return color_make(0x14, 0x4d, 0x8e, 0xff);
-            case 0x0400: return color_make(0xa2, 0xa2, 0xa6, 0xff);
-            case 0x0401: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0410: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x0411: return color_make(0x7d, 0x55, 0x49, 0xff);
-            case 0x0420: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0421: return color_make(0x75, 0x49, 0x3c, 0xff);
-            case 0x0430: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0431: return color_make(0x61, 0x65, 0x82, 0xff);
-            case 0x0440: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0441: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x0450: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0451: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0460: return color_make(0x7d, 0x55, 0x49, 0xff);
-            case 0x0470: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0471: return color_make(0x08, 0x45, 0x79, 0xff);
-            case 0x0480: return color_make(0x75, 0x49, 0x3c, 0xff);
-            case 0x0481: return color_make(0xa2, 0xa2, 0xa6, 0xff);
-            case 0x0490: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0491: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x04a0: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x04b0: return color_make(0x38, 0x65, 0x9a, 0xff);
-            case 0x04b1: return color_make(0x00, 0x30, 0x69, 0xff);
-            case 0x04c0: return color_make(0x49, 0x28, 0x20, 0xff);
-            case 0x04d0: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x0500: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0501: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0510: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0511: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0520: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0521: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0522: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0530: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0531: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0540: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0541: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0542: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0550: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0551: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0560: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0561: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0570: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0571: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0580: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x0581: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0590: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0591: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0592: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x05a0: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x05a1: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x05b0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x05b1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x05b2: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x05c0: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x05c1: return color_make(0x18, 0x55, 0x8a, 0xff);
-            case 0x05d0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x05d1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0600: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0601: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0610: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0611: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0620: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0621: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0622: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0630: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0631: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0640: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0641: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0642: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0650: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0651: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0660: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0661: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0670: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0671: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x0680: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0681: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0690: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0691: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0692: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06a0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06a1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06b0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06b1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06b2: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06c0: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x06c1: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x06d0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x06d1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0700: return color_make(0x04, 0x28, 0x08, 0xff);
-            case 0x0701: return color_make(0x04, 0x28, 0x08, 0xff);
-            case 0x0710: return color_make(0x0c, 0x30, 0x0c, 0xff);
-            case 0x0711: return color_make(0x04, 0x28, 0x08, 0xff);
-            case 0x0720: return color_make(0x04, 0x28, 0x08, 0xff);
-            case 0x0721: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0730: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0731: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0740: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0741: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0750: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0751: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0760: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0761: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0770: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0771: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0780: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0781: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x0790: return color_make(0x0c, 0x30, 0x0c, 0xff);
-            case 0x0791: return color_make(0x0c, 0x30, 0x0c, 0xff);
-            case 0x07a0: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x07a1: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x07b0: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x07b1: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x07c0: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x07c1: return color_make(0x20, 0x59, 0x65, 0xff);
-            case 0x07d0: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x07d1: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0800: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x0802: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0804: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0810: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x0812: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0814: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0820: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x0822: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0824: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0830: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0832: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0834: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0840: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0841: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0843: return color_make(0x00, 0x28, 0x5d, 0xff);
-            case 0x0844: return color_make(0x00, 0x28, 0x5d, 0xff);
-            case 0x0846: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0847: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0850: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0852: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0854: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0860: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0862: return color_make(0x30, 0x49, 0x59, 0xff);
-            case 0x0864: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0870: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0872: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0874: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0880: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0882: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0884: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0890: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0891: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0893: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0894: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x0896: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0897: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x08a0: return color_make(0x86, 0x86, 0x9a, 0xff);
-            case 0x08a2: return color_make(0x4d, 0x55, 0x71, 0xff);
-            case 0x08a4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x08b0: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08b2: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08b4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x08c0: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08c2: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08c4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x08d0: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08d2: return color_make(0x96, 0x96, 0xa2, 0xff);
-            case 0x08d4: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x0900: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0902: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0904: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0910: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0912: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0914: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0920: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0922: return color_make(0x8e, 0x8e, 0x9e, 0xff);
-            case 0x0924: return color_make(0x71, 0x75, 0x8e, 0xff);
-            case 0x0930: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0932: return color_make(0xaa, 0x86, 0x4d, 0xff);
-            case 0x0934: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0940: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0941: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0943: return color_make(0xaa, 0x86, 0x4d, 0xff);
-            case 0x0944: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x0946: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0947: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0950: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0952: return color_make(0xaa, 0x86, 0x4d, 0xff);
-            case 0x0954: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0960: return color_make(0x69, 0x6d, 0x86, 0xff);
-            case 0x0962: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x0964: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0970: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0972: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x0974: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0980: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0982: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x0984: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0990: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0991: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0993: return color_make(0x3c, 0x24, 0x20, 0xff);
-            case 0x0994: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x0996: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x0997: return color_make(0x41, 0x49, 0x69, 0xff);
-            case 0x09a0: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x09a2: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x09a4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x09b0: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x09b2: return color_make(0x8a, 0x61, 0x4d, 0xff);
-            case 0x09b4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x09c0: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x09c2: return color_make(0x8a, 0x61, 0x4d, 0xff);
-            case 0x09c4: return color_make(0x59, 0x61, 0x7d, 0xff);
-            case 0x09d0: return color_make(0x14, 0x49, 0x49, 0xff);
-            case 0x09d2: return color_make(0x8a, 0x61, 0x4d, 0xff);
-            case 0x09d4: return color_make(0x41, 0x49, 0x69, 0xff);
-            default:     break;
-           }
-         break;
+static const Pud_Color _swamp_palette[] =
+{
+   UNKNOWN_COLOR,
+   { 0x18, 0x20, 0x08, 0xff },
+   { 0x14, 0x1c, 0x08, 0xff },
+   { 0x61, 0x34, 0x04, 0xff },
+   { 0x59, 0x2c, 0x00, 0xff },
+   { 0x69, 0x3c, 0x08, 0xff },
+   { 0x49, 0x24, 0x00, 0xff },
+   { 0x75, 0x4d, 0x10, 0xff },
+   { 0x55, 0x28, 0x00, 0xff },
+   { 0x6d, 0x45, 0x0c, 0xff },
+   { 0x24, 0x34, 0x08, 0xff },
+   { 0x45, 0x2c, 0x1c, 0xff },
+   { 0x51, 0x38, 0x28, 0xff },
+   { 0x30, 0x1c, 0x14, 0xff },
+   { 0x28, 0x14, 0x0c, 0xff },
+   { 0x38, 0x24, 0x18, 0xff },
+   { 0x38, 0x28, 0x28, 0xff },
+   { 0x41, 0x28, 0x0c, 0xff },
+   { 0x7d, 0x59, 0x41, 0xff },
+   { 0x41, 0x34, 0x30, 0xff },
+   { 0x49, 0x3c, 0x38, 0xff },
+   { 0x18, 0x10, 0x10, 0xff },
+   { 0x71, 0x65, 0x61, 0xff },
+   { 0x5d, 0x51, 0x4d, 0xff },
+   { 0x86, 0x79, 0x75, 0xff },
+   { 0x79, 0x6d, 0x69, 0xff },
+   { 0x7d, 0x55, 0x18, 0xff },
+   { 0x28, 0x30, 0x0c, 0xff },
+   { 0x3c, 0x1c, 0x00, 0xff },
+   { 0x24, 0x18, 0x18, 0xff },
+   { 0x55, 0x45, 0x45, 0xff },
+   { 0x2c, 0x20, 0x20, 0xff },
+   { 0x5d, 0x3c, 0x20, 0xff },
+   { 0x69, 0x59, 0x55, 0xff },
+};
 
-      case PUD_ERA_WASTELAND:
-         switch (tile)
-           {
-            case 0x0010: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0011: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0012: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0013: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0015: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0016: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0017: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0020: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0021: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0022: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0023: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0025: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0026: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0027: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0030: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0031: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0032: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0034: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0035: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0036: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0037: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0038: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0039: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x003a: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x003b: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0040: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0041: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x0042: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0044: return color_make(0x3c, 0x1c, 0x08, 0xff);
-            case 0x0045: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x0046: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0047: return color_make(0x3c, 0x1c, 0x08, 0xff);
-            case 0x0048: return color_make(0x3c, 0x1c, 0x08, 0xff);
-            case 0x0049: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x004a: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x004b: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0050: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0051: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0052: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0054: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0055: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0056: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0057: return color_make(0xa6, 0x59, 0x14, 0xff);
-            case 0x0058: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0059: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x005a: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x005b: return color_make(0x8e, 0x49, 0x04, 0xff);
-            case 0x005c: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x005d: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x005e: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x005f: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0060: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0061: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0062: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0064: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0065: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0066: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0067: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0068: return color_make(0x51, 0x1c, 0x08, 0xff);
-            case 0x0069: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x006a: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x006b: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x006c: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x006d: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x006e: return color_make(0x51, 0x1c, 0x08, 0xff);
-            case 0x006f: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0070: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0071: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0072: return color_make(0x04, 0x10, 0x00, 0xff);
-            case 0x0080: return color_make(0x18, 0x10, 0x10, 0xff);
-            case 0x0081: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0082: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0083: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0090: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0092: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0094: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x00a0: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x00a2: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x00a4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x00b0: return color_make(0x8e, 0x86, 0x82, 0xff);
-            case 0x00b2: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x00b4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x00c0: return color_make(0x24, 0x18, 0x18, 0xff);
-            case 0x00c2: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x00c4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0100: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0101: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0110: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0111: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0120: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0121: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0122: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0130: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0131: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0140: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0141: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0142: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0150: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0151: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0160: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0161: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0170: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0171: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0180: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0181: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x0190: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0191: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0192: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01a0: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x01a1: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x01b0: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01b1: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01b2: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01c0: return color_make(0x10, 0x20, 0x2c, 0xff);
-            case 0x01c1: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01d0: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x01d1: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0200: return color_make(0x2c, 0x10, 0x04, 0xff);
-            case 0x0201: return color_make(0x0c, 0x28, 0x34, 0xff);
-            case 0x0210: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0211: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0220: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0221: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0222: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0230: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0231: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0240: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0241: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0242: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0250: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0251: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0260: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0261: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0270: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0271: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0280: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0281: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x0290: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x0291: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0292: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x02a0: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x02a1: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x02b0: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x02b1: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x02b2: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x02c0: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x02c1: return color_make(0x0c, 0x20, 0x2c, 0xff);
-            case 0x02d0: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x02d1: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0300: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0301: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0310: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0311: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0320: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0321: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x0322: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0330: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0331: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0340: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0341: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x0342: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0350: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0351: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0360: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0361: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0370: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0371: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0380: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0381: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0390: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0391: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0392: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x03a0: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x03a1: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x03b0: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x03b1: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x03b2: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x03c0: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x03c1: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x03d0: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x03d1: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0400: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0401: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0410: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0411: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0420: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0421: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0430: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0431: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0440: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0441: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0450: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0451: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0460: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0470: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0471: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0480: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0481: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0490: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0491: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x04a0: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x04b0: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x04b1: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x04c0: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x04d0: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0500: return color_make(0x51, 0x1c, 0x08, 0xff);
-            case 0x0501: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0510: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0511: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0520: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0521: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0522: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0530: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0531: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0540: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0541: return color_make(0x45, 0x18, 0x08, 0xff);
-            case 0x0542: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x0550: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0551: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0560: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0561: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0570: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0571: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0580: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x0581: return color_make(0x51, 0x1c, 0x08, 0xff);
-            case 0x0590: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0591: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0592: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x05a0: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x05a1: return color_make(0x4d, 0x28, 0x0c, 0xff);
-            case 0x05b0: return color_make(0x8e, 0x49, 0x04, 0xff);
-            case 0x05b1: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x05b2: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x05c0: return color_make(0x45, 0x24, 0x08, 0xff);
-            case 0x05c1: return color_make(0x41, 0x20, 0x08, 0xff);
-            case 0x05d0: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x05d1: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0600: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0601: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0610: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0611: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0620: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0621: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0622: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0630: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0631: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0640: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0641: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0642: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0650: return color_make(0x65, 0x28, 0x04, 0xff);
-            case 0x0651: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0660: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0661: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0670: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0671: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0680: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0681: return color_make(0x71, 0x30, 0x04, 0xff);
-            case 0x0690: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0691: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0692: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x06a0: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x06a1: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x06b0: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x06b1: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x06b2: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x06c0: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x06c1: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x06d0: return color_make(0x65, 0x28, 0x04, 0xff);
-            case 0x06d1: return color_make(0x65, 0x28, 0x04, 0xff);
-            case 0x0700: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0701: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0710: return color_make(0x51, 0x1c, 0x08, 0xff);
-            case 0x0711: return color_make(0x38, 0x14, 0x08, 0xff);
-            case 0x0720: return color_make(0x08, 0x18, 0x00, 0xff);
-            case 0x0721: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0730: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0731: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0740: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0741: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0750: return color_make(0x38, 0x14, 0x08, 0xff);
-            case 0x0751: return color_make(0x38, 0x14, 0x08, 0xff);
-            case 0x0760: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0761: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0770: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0771: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x0780: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0781: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x0790: return color_make(0x45, 0x18, 0x08, 0xff);
-            case 0x0791: return color_make(0x38, 0x14, 0x08, 0xff);
-            case 0x07a0: return color_make(0x04, 0x10, 0x00, 0xff);
-            case 0x07a1: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x07b0: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x07b1: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x07c0: return color_make(0x1c, 0x24, 0x00, 0xff);
-            case 0x07c1: return color_make(0x04, 0x10, 0x00, 0xff);
-            case 0x07d0: return color_make(0x34, 0x30, 0x00, 0xff);
-            case 0x07d1: return color_make(0x34, 0x30, 0x00, 0xff);
-            case 0x0800: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0802: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0804: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0810: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0812: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0814: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0820: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0822: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0824: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0830: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0832: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0834: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0840: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0841: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0843: return color_make(0x18, 0x10, 0x10, 0xff);
-            case 0x0844: return color_make(0x24, 0x18, 0x18, 0xff);
-            case 0x0846: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0847: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0850: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0852: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0854: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0860: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0862: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0864: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0870: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0872: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0874: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0880: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0882: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0884: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0890: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0891: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0893: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0894: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0896: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0897: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x08a0: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x08a2: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x08a4: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x08b0: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08b2: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08b4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x08c0: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08c2: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08c4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x08d0: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08d2: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08d4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0900: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0902: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0904: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0910: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0912: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0914: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0920: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0922: return color_make(0x79, 0x38, 0x04, 0xff);
-            case 0x0924: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0930: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0932: return color_make(0xa6, 0x59, 0x14, 0xff);
-            case 0x0934: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0940: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0941: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0943: return color_make(0xa6, 0x59, 0x14, 0xff);
-            case 0x0944: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0946: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0947: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0950: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0952: return color_make(0xa6, 0x59, 0x14, 0xff);
-            case 0x0954: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0960: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0962: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0964: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0970: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0972: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0974: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0980: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0982: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0984: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x0990: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0991: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0993: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0994: return color_make(0x59, 0x34, 0x18, 0xff);
-            case 0x0996: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0997: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x09a0: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x09a2: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09a4: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x09b0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09b2: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x09b4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x09c0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09c2: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x09c4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x09d0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09d2: return color_make(0x82, 0x41, 0x04, 0xff);
-            case 0x09d4: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            default:     break;
-           }
-         break;
+static const uint8_t _swamp_tiles[PUD_TILES_TABLE_SIZE] =
+{
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  4,  0,  5,  6,  3,  3,  3,  7,  0,  0,  0,  0,  0,  0,
+    4,  4,  8,  0,  8,  4,  4,  4,  9, 10,  0,  0,  0,  0,  0,  0,
+   11, 12, 12,  0, 11, 11, 12, 12, 13, 12, 12,  1, 11, 10, 14, 11,
+   15, 11, 11,  0, 15, 15, 16, 11, 11, 15, 11, 11, 11,  1, 15, 10,
+   17, 18, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19, 20, 21, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 19,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   23,  0, 11,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  0, 24,  0, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16,  0, 26,  0, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  1,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   27, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28,  3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    8,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 20,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   16, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   21, 30,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3, 31,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11,  4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    6, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    9,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    4,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    3,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   28, 26,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   15, 11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 15, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   13, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   32, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   12, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   17, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 12,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   18, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   11, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 22,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 22,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 22,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 25,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 25,  0, 21, 31,  0, 22, 22,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 25,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 16,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 25,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 25,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   25, 25,  0, 22, 25,  0, 19, 22,  0,  0,  0,  0,  0,  0,  0,  0,
+   25,  0, 20,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  0, 24,  0, 33,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  0, 24,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   24,  0, 24,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 11,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 11,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 11,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 26,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30, 30,  0, 26, 16,  0, 22, 22,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 26,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 19,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   30,  0, 16,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 16,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   20, 20,  0, 29,  6,  0, 19, 22,  0,  0,  0,  0,  0,  0,  0,  0,
+   20,  0, 16,  0, 19,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   31,  0, 26,  0, 33,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   31,  0, 26,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   31,  0, 26,  0, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
 
-      case PUD_ERA_SWAMP:
-         switch (tile)
-           {
-            case 0x0010: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0011: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0012: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0013: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0020: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0021: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0022: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0023: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0030: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0031: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0032: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0034: return color_make(0x69, 0x3c, 0x08, 0xff);
-            case 0x0035: return color_make(0x49, 0x24, 0x00, 0xff);
-            case 0x0036: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0037: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0038: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0039: return color_make(0x75, 0x4d, 0x10, 0xff);
-            case 0x0040: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0041: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0042: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0044: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0045: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0046: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0047: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0048: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0049: return color_make(0x24, 0x34, 0x08, 0xff);
-            case 0x0050: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0051: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0052: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0054: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0055: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0056: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0057: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0058: return color_make(0x30, 0x1c, 0x14, 0xff);
-            case 0x0059: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x005a: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x005b: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x005c: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x005d: return color_make(0x24, 0x34, 0x08, 0xff);
-            case 0x005e: return color_make(0x28, 0x14, 0x0c, 0xff);
-            case 0x005f: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0060: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0061: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0062: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0064: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0065: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0066: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0067: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0068: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0069: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x006a: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x006b: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x006c: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x006d: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x006e: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x006f: return color_make(0x24, 0x34, 0x08, 0xff);
-            case 0x0070: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0071: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x0072: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0080: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0081: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0082: return color_make(0x18, 0x10, 0x10, 0xff);
-            case 0x0083: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0090: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0092: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0094: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x00a0: return color_make(0x5d, 0x51, 0x4d, 0xff);
-            case 0x00a2: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x00a4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x00b0: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x00b2: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x00b4: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x00c0: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x00c2: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x00c4: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0100: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0101: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0110: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0111: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0120: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0121: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0122: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0130: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0131: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0140: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0141: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0142: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0150: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0151: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0160: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0161: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0170: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0171: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0180: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0181: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x0190: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0191: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0192: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01a0: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x01a1: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x01b0: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01b1: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01b2: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01c0: return color_make(0x14, 0x1c, 0x08, 0xff);
-            case 0x01c1: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01d0: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x01d1: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0200: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0201: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0210: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0211: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0220: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0221: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0222: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0230: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0231: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0240: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0241: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0242: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0250: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0251: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0260: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0261: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x0270: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0271: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0280: return color_make(0x28, 0x30, 0x0c, 0xff);
-            case 0x0281: return color_make(0x28, 0x30, 0x0c, 0xff);
-            case 0x0290: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0291: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0292: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x02a0: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x02a1: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x02b0: return color_make(0x3c, 0x1c, 0x00, 0xff);
-            case 0x02b1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x02b2: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x02c0: return color_make(0x18, 0x20, 0x08, 0xff);
-            case 0x02c1: return color_make(0x28, 0x30, 0x0c, 0xff);
-            case 0x02d0: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x02d1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0300: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0301: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0310: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0311: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0320: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0321: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0322: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0330: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0331: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0340: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0341: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0342: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x0350: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0351: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0360: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0361: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0370: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0371: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0380: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0381: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0390: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0391: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0392: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x03a0: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x03a1: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x03b0: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x03b1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x03b2: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x03c0: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x03c1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x03d0: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x03d1: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0400: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0401: return color_make(0x24, 0x18, 0x18, 0xff);
-            case 0x0410: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0411: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0420: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0421: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0430: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0431: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0440: return color_make(0x18, 0x10, 0x10, 0xff);
-            case 0x0441: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0450: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0451: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0460: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0470: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0471: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0480: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0481: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0490: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0491: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x04a0: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x04b0: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x04b1: return color_make(0x55, 0x28, 0x00, 0xff);
-            case 0x04c0: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x04d0: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0500: return color_make(0x3c, 0x1c, 0x00, 0xff);
-            case 0x0501: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0510: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0511: return color_make(0x30, 0x1c, 0x14, 0xff);
-            case 0x0520: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0521: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0522: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x0530: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0531: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0540: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0541: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0542: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0550: return color_make(0x49, 0x24, 0x00, 0xff);
-            case 0x0551: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0560: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0561: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0570: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0571: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0580: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x0581: return color_make(0x6d, 0x45, 0x0c, 0xff);
-            case 0x0590: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0591: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0592: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x05a0: return color_make(0x59, 0x2c, 0x00, 0xff);
-            case 0x05a1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x05b0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x05b1: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x05b2: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x05c0: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x05c1: return color_make(0x61, 0x34, 0x04, 0xff);
-            case 0x05d0: return color_make(0x3c, 0x1c, 0x00, 0xff);
-            case 0x05d1: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x0600: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0601: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0610: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0611: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0620: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0621: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0622: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0630: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0631: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0640: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0641: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0642: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0650: return color_make(0x30, 0x1c, 0x14, 0xff);
-            case 0x0651: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0660: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0661: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0670: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0671: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0680: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0681: return color_make(0x38, 0x24, 0x18, 0xff);
-            case 0x0690: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0691: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0692: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x06a0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x06a1: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x06b0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x06b1: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x06b2: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x06c0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x06c1: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x06d0: return color_make(0x30, 0x1c, 0x14, 0xff);
-            case 0x06d1: return color_make(0x30, 0x1c, 0x14, 0xff);
-            case 0x0700: return color_make(0x5d, 0x3c, 0x20, 0xff);
-            case 0x0701: return color_make(0x5d, 0x3c, 0x20, 0xff);
-            case 0x0710: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0711: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0720: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x0721: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0730: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x0731: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0740: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x0741: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0750: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0751: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0760: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0761: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x0770: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0771: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0780: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x0781: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x0790: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0791: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x07a0: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x07a1: return color_make(0x41, 0x28, 0x0c, 0xff);
-            case 0x07b0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x07b1: return color_make(0x51, 0x38, 0x28, 0xff);
-            case 0x07c0: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x07c1: return color_make(0x7d, 0x59, 0x41, 0xff);
-            case 0x07d0: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x07d1: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0800: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0802: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0804: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0810: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0812: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0814: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0820: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0822: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0824: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0830: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0832: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0834: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0840: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0841: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0843: return color_make(0x18, 0x10, 0x10, 0xff);
-            case 0x0844: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x0846: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0847: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0850: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0852: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0854: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0860: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0862: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0864: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0870: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0872: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0874: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0880: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0882: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0884: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0890: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0891: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0893: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0894: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x0896: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0897: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x08a0: return color_make(0x79, 0x6d, 0x69, 0xff);
-            case 0x08a2: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x08a4: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x08b0: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08b2: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08b4: return color_make(0x69, 0x59, 0x55, 0xff);
-            case 0x08c0: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08c2: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08c4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x08d0: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08d2: return color_make(0x86, 0x79, 0x75, 0xff);
-            case 0x08d4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0900: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0902: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0904: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0910: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0912: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0914: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0920: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0922: return color_make(0x45, 0x2c, 0x1c, 0xff);
-            case 0x0924: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0930: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0932: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x0934: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0940: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0941: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0943: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x0944: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0946: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0947: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0950: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0952: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x0954: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0960: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0962: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0964: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0970: return color_make(0x55, 0x45, 0x45, 0xff);
-            case 0x0972: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0974: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0980: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0982: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x0984: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x0990: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0991: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x0993: return color_make(0x24, 0x18, 0x18, 0xff);
-            case 0x0994: return color_make(0x49, 0x24, 0x00, 0xff);
-            case 0x0996: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x0997: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x09a0: return color_make(0x49, 0x3c, 0x38, 0xff);
-            case 0x09a2: return color_make(0x38, 0x28, 0x28, 0xff);
-            case 0x09a4: return color_make(0x41, 0x34, 0x30, 0xff);
-            case 0x09b0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09b2: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x09b4: return color_make(0x69, 0x59, 0x55, 0xff);
-            case 0x09c0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09c2: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x09c4: return color_make(0x71, 0x65, 0x61, 0xff);
-            case 0x09d0: return color_make(0x2c, 0x20, 0x20, 0xff);
-            case 0x09d2: return color_make(0x7d, 0x55, 0x18, 0xff);
-            case 0x09d4: return color_make(0x71, 0x65, 0x61, 0xff);
-            default:     break;
-           }
-         break;
+/* ================================================== */
+
+static const Pud_Color _unknown_palette[] =
+{
+   UNKNOWN_COLOR,
+};
 
-     }
+static const uint8_t _unknown_tiles[PUD_TILES_TABLE_SIZE] = { 0 };
+
+static const Pud_Tile_Colors _eras[] =
+{
+   [PUD_ERA_FOREST] = {
+      _forest_palette, _forest_tiles, PALETTE_SIZE(_forest_palette)
+   },
+   [PUD_ERA_WINTER] = {
+      _winter_palette, _winter_tiles, PALETTE_SIZE(_winter_palette)
+   },
+   [PUD_ERA_WASTELAND] = {
+      _wasteland_palette, _wasteland_tiles, PALETTE_SIZE(_wasteland_palette)
+   },
+   [PUD_ERA_SWAMP] = {
+      _swamp_palette, _swamp_tiles, PALETTE_SIZE(_swamp_palette)
+   },
+};
+
+static const Pud_Tile_Colors _unknown =
+{
+   _unknown_palette, _unknown_tiles, PALETTE_SIZE(_unknown_palette)
+};
+
+const Pud_Tile_Colors *
+pud_tile_colors_get(Pud_Era era)
+{
+   return ((unsigned)era > PUD_ERA_SWAMP) ? &_unknown : &(_eras[era]);
+}
+
+Pud_Color
+pud_tile_to_color(Pud_Era   era,
+                  uint16_t  tile)
+{
+   const Pud_Tile_Colors *const tc = pud_tile_colors_get(era);
+   const unsigned int idx = PUD_TILE_COLOR_INDEX(tc, tile);
 
-   ERR("Unhandled tile [0x%04x] for era %s", tile, pud_era2str(era));
-   return color_make(0xff, 0x00, 0xff, 0xff); // Flashy to be seen (debug)
+   if (idx == 0)
+     ERR("Unhandled tile [0x%04x] for era %s", tile, pud_era2str(era));
+   return tc->palette[idx];
 }
@@ -0,0 +1,327 @@
+/*
+ * units.c
+ * libpud
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "pud_private.h"
+
+/*
+ * The units are bucketed in a uniform grid, by the cell of their origin.
+ * A unit spreads over at most (max_w x max_h) tiles, so a query of an
+ * area also looks at the cells just before it. Cells are linked lists
+ * of unit indexes ('heads' and 'next'), so a unit is added in O(1).
+ */
+
+static inline void
+_unit_size(const Pud           *pud,
+           const Pud_Unit_Data *u,
+           unsigned int        *w,
+           unsigned int        *h)
+{
+   const unsigned int count = sizeof(pud->unit_data) / sizeof(pud->unit_data[0]);
+
+   /* Unknown units, or units without size, still cover their origin */
+   *w = (u->type < count) ? pud->unit_data[u->type].size_w : 0;
+   *h = (u->type < count) ? pud->unit_data[u->type].size_h : 0;
+   if (*w == 0) *w = 1;
+   if (*h == 0) *h = 1;
+}
+
+static void
+_index_insert(Pud             *pud,
+              Pud_Units_Index *ix,
+              unsigned int     unit)
+{
+   const Pud_Unit_Data *const u = &(pud->units[unit]);
+   unsigned int w, h, x, y, x1, y1, cell, bit;
+
+   ix->next[unit] = -1;
+   ix->count = unit + 1;
+
+   /* Units out of the map are not reachable by the queries */
+   if ((u->x >= ix->map_w) || (u->y >= ix->map_h)) return;
+
+   cell = ((u->y >> PUD_UNITS_CELL_SHIFT) * ix->cells_w) +
+      (u->x >> PUD_UNITS_CELL_SHIFT);
+   ix->next[unit] = ix->heads[cell];
+   ix->heads[cell] = (int)unit;
+
+   _unit_size(pud, u, &w, &h);
+   if (w > ix->max_w) ix->max_w = w;
+   if (h > ix->max_h) ix->max_h = h;
+
+   x1 = u->x + w;
+   y1 = u->y + h;
+   if (x1 > ix->map_w) x1 = ix->map_w;
+   if (y1 > ix->map_h) y1 = ix->map_h;
+   for (y = u->y; y < y1; y++)
+     for (x = u->x; x < x1; x++)
+       {
+          bit = (y * ix->map_w) + x;
+          if (ix->occupancy[bit >> 3] & (1 << (bit & 7)))
+            ix->overlaps++;
+          else
+            ix->occupancy[bit >> 3] |= (1 << (bit & 7));
+       }
+}
+
+static Pud_Units_Index *
+_index_get(Pud *pud)
+{
+   /* Loading UNIT or UDTA invalidates the index, so do it first */
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(UNIT) | PUD_SECTION_BIT(UDTA), NULL);
+
+   if ((!pud->units_index) || (pud->units_index->stale))
+     {
+        if (!pud_units_index_build(pud)) return NULL;
+     }
+   return pud->units_index;
+}
+
+Pud_Bool
+pud_units_index_build(Pud *pud)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+
+   Pud_Units_Index *ix = pud->units_index;
+   unsigned int i, cells;
+   void *ptr;
+
+   PUD_SECTIONS_LOAD(pud, PUD_SECTION_BIT(UNIT) | PUD_SECTION_BIT(UDTA), PUD_FALSE);
+
+   if (!ix)
+     {
+        ix = calloc(1, sizeof(*ix));
+        if (!ix) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        pud->units_index = ix;
+     }
+
+   /* Whatever happens, the index is rebuilt by the next query */
+   ix->stale = PUD_TRUE;
+
+   ix->map_w = pud->map_w;
+   ix->map_h = pud->map_h;
+   ix->cells_w = (ix->map_w + (1 << PUD_UNITS_CELL_SHIFT) - 1) >> PUD_UNITS_CELL_SHIFT;
+   ix->cells_h = (ix->map_h + (1 << PUD_UNITS_CELL_SHIFT) - 1) >> PUD_UNITS_CELL_SHIFT;
+   cells = ix->cells_w * ix->cells_h;
+
+   ptr = realloc(ix->heads, (cells ? cells : 1) * sizeof(int));
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   ix->heads = ptr;
+
+   ptr = realloc(ix->occupancy, (((size_t)ix->map_w * ix->map_h) + 7) / 8 + 1);
+   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+   ix->occupancy = ptr;
+
+   if (ix->next_size < pud->units_count)
+     {
+        ptr = realloc(ix->next, pud->units_count * sizeof(int));
+        if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+        ix->next = ptr;
+        ix->next_size = pud->units_count;
+     }
+
+   for (i = 0; i < cells; i++) ix->heads[i] = -1;
+   memset(ix->occupancy, 0, (((size_t)ix->map_w * ix->map_h) + 7) / 8 + 1);
+   ix->count = 0;
+   ix->max_w = 1;
+   ix->max_h = 1;
+   ix->overlaps = 0;
+
+   for (i = 0; i < pud->units_count; i++)
+     _index_insert(pud, ix, i);
+
+   ix->stale = PUD_FALSE;
+   return PUD_TRUE;
+}
+
+void
+pud_units_index_free(Pud *pud)
+{
+   Pud_Units_Index *const ix = (pud) ? pud->units_index : NULL;
+
+   if (!ix) return;
+   free(ix->heads);
+   free(ix->next);
+   free(ix->occupancy);
+   free(ix);
+   pud->units_index = NULL;
+}
+
+void
+pud_units_index_add(Pud          *pud,
+                    unsigned int  unit)
+{
+   Pud_Units_Index *const ix = pud->units_index;
+   unsigned int size;
+   void *ptr;
+
+   if ((!ix) || (ix->stale)) return;
+
+   /* Only appended units are maintained, anything else is a rebuild */
+   if (unit != ix->count)
+     {
+        ix->stale = PUD_TRUE;
+        return;
+     }
+
+   if (unit >= ix->next_size)
+     {
+        size = (ix->next_size) ? ix->next_size * 2 : 16;
+        ptr = realloc(ix->next, size * sizeof(int));
+        if (!ptr)
+          {
+             ix->stale = PUD_TRUE;
+             DIE_RETURN(VOID, "Failed to allocate memory");
+          }
+        ix->next = ptr;
+        ix->next_size = size;
+     }
+
+   _index_insert(pud, ix, unit);
+}
+
+void
+pud_units_index_invalidate(Pud *pud)
+{
+   if (pud->units_index) pud->units_index->stale = PUD_TRUE;
+}
+
+unsigned int
+pud_units_in_rect(Pud            *pud,
+                  const Pud_Rect *rect,
+                  unsigned int   *units,
+                  unsigned int    max)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, 0);
+
+   const Pud_Units_Index *ix;
+   const Pud_Unit_Data *u;
+   unsigned int x0, y0, x1, y1, cx, cy, cx0, cy0, cx1, cy1, w, h, n = 0;
+   unsigned int k, kept;
+   int i;
+
+   if ((!rect) || ((!units) && (max > 0))) DIE_RETURN(0, "Invalid inputs");
+   ix = _index_get(pud);
+   if (!ix) return 0;
+
+   if ((rect->x >= ix->map_w) || (rect->y >= ix->map_h)) return 0;
+   x0 = rect->x;
+   y0 = rect->y;
+   x1 = (rect->w > ix->map_w - x0) ? ix->map_w : x0 + rect->w;
+   y1 = (rect->h > ix->map_h - y0) ? ix->map_h : y0 + rect->h;
+   if ((x0 >= x1) || (y0 >= y1)) return 0;
+
+   /* Units starting up to a footprint before the area may reach it */
+   cx0 = ((x0 >= ix->max_w) ? x0 - ix->max_w + 1 : 0) >> PUD_UNITS_CELL_SHIFT;
+   cy0 = ((y0 >= ix->max_h) ? y0 - ix->max_h + 1 : 0) >> PUD_UNITS_CELL_SHIFT;
+   cx1 = (x1 - 1) >> PUD_UNITS_CELL_SHIFT;
+   cy1 = (y1 - 1) >> PUD_UNITS_CELL_SHIFT;
+
+   for (cy = cy0; cy <= cy1; cy++)
+     for (cx = cx0; cx <= cx1; cx++)
+       for (i = ix->heads[(cy * ix->cells_w) + cx]; i >= 0; i = ix->next[i])
+         {
+            u = &(pud->units[i]);
+            _unit_size(pud, u, &w, &h);
+            if ((u->x + w <= x0) || (u->x >= x1) ||
+                (u->y + h <= y0) || (u->y >= y1))
+              continue;
+
+            /* Units are reported in the order of pud->units: the output
+             * is kept sorted, and holds the 'max' lowest indexes */
+            kept = (n < max) ? n : max;
+            n++;
+            if (kept == max)
+              {
+                 if ((max == 0) || ((unsigned int)i > units[max - 1])) continue;
+                 kept--; /* The largest one is dropped */
+              }
+            for (k = kept; (k > 0) && (units[k - 1] > (unsigned int)i); k--)
+              units[k] = units[k - 1];
+            units[k] = (unsigned int)i;
+         }
+
+   return n;
+}
+
+int
+pud_unit_at(Pud          *pud,
+            unsigned int  x,
+            unsigned int  y)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, -1);
+
+   const Pud_Units_Index *ix;
+   const Pud_Unit_Data *u;
+   unsigned int cx, cy, cx0, cy0, w, h;
+   int i, found = -1;
+
+   ix = _index_get(pud);
+   if ((!ix) || (x >= ix->map_w) || (y >= ix->map_h)) return -1;
+
+   /* Quick reject: most tiles are not covered */
+   if (!(ix->occupancy[((y * ix->map_w) + x) >> 3] & (1 << (((y * ix->map_w) + x) & 7))))
+     return -1;
+
+   cx0 = ((x >= ix->max_w) ? x - ix->max_w + 1 : 0) >> PUD_UNITS_CELL_SHIFT;
+   cy0 = ((y >= ix->max_h) ? y - ix->max_h + 1 : 0) >> PUD_UNITS_CELL_SHIFT;
+
+   /* The last unit is the one on top */
+   for (cy = cy0; cy <= (y >> PUD_UNITS_CELL_SHIFT); cy++)
+     for (cx = cx0; cx <= (x >> PUD_UNITS_CELL_SHIFT); cx++)
+       for (i = ix->heads[(cy * ix->cells_w) + cx]; i >= 0; i = ix->next[i])
+         {
+            if (i <= found) continue;
+            u = &(pud->units[i]);
+            _unit_size(pud, u, &w, &h);
+            if ((x >= u->x) && (x < u->x + w) && (y >= u->y) && (y < u->y + h))
+              found = i;
+         }
+
+   return found;
+}
+
+const uint8_t *
+pud_units_occupancy_get(Pud          *pud,
+                        unsigned int *overlaps)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, NULL);
+
+   const Pud_Units_Index *const ix = _index_get(pud);
+
+   if (!ix) return NULL;
+   if (overlaps) *overlaps = ix->overlaps;
+   return ix->occupancy;
+}
+
+Pud_Bool
+pud_units_area_free_is(Pud            *pud,
+                       const Pud_Rect *rect)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+
+   const Pud_Units_Index *ix;
+   unsigned int x, y, bit;
+
+   if (!rect) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   ix = _index_get(pud);
+   if (!ix) return PUD_FALSE;
+
+   /* Out of the map is never free */
+   if ((rect->x >= ix->map_w) || (rect->y >= ix->map_h) ||
+       (rect->w > ix->map_w - rect->x) || (rect->h > ix->map_h - rect->y))
+     return PUD_FALSE;
+
+   for (y = rect->y; y < rect->y + rect->h; y++)
+     for (x = rect->x; x < rect->x + rect->w; x++)
+       {
+          bit = (y * ix->map_w) + x;
+          if (ix->occupancy[bit >> 3] & (1 << (bit & 7)))
+            return PUD_FALSE;
+       }
+
+   return PUD_TRUE;
+}
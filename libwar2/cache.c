@@ -0,0 +1,216 @@
+/*
+ * cache.c
+ * libwar2
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "war2_private.h"
+
+/*
+ * Decompressed entries are kept until the cache exceeds its budget. Then
+ * the least recently used ones are evicted, unless they are still
+ * referenced: those stay until they are released. An entry that is not
+ * (or no longer) in the cache is freed by its last war2_entry_unref().
+ *
+ * The cache and the references of its entries are protected by
+ * 'cache_lock'. Decoding happens out of the lock, so threads missing
+ * different entries decode them in parallel.
+ */
+
+static void
+_entry_free(War2_Entry *e)
+{
+   free((unsigned char *)e->data);
+   free(e);
+}
+
+static void
+_lru_unlink(War2_Data  *w2,
+            War2_Entry *e)
+{
+   if (e->prev) e->prev->next = e->next;
+   else w2->lru_first = e->next;
+   if (e->next) e->next->prev = e->prev;
+   else w2->lru_last = e->prev;
+   e->prev = NULL;
+   e->next = NULL;
+}
+
+static void
+_lru_push(War2_Data  *w2,
+          War2_Entry *e)
+{
+   e->prev = NULL;
+   e->next = w2->lru_first;
+   if (w2->lru_first) w2->lru_first->prev = e;
+   else w2->lru_last = e;
+   w2->lru_first = e;
+}
+
+static void
+_entry_evict(War2_Data  *w2,
+             War2_Entry *e)
+{
+   _lru_unlink(w2, e);
+   w2->cache[e->id] = NULL;
+   w2->cache_size -= e->size;
+   e->w2 = NULL;
+   if (e->refs == 0) _entry_free(e);
+}
+
+static void
+_cache_trim(War2_Data *w2)
+{
+   War2_Entry *e, *prev;
+
+   for (e = w2->lru_last; (e) && (w2->cache_size > w2->cache_budget); e = prev)
+     {
+        prev = e->prev;
+        if (e->refs == 0) _entry_evict(w2, e);
+     }
+}
+
+War2_Entry *
+war2_cache_lookup(War2_Data    *w2,
+                  unsigned int  entry)
+{
+   War2_Entry *e;
+
+   if (entry >= w2->entries_count) return NULL;
+
+   pthread_mutex_lock(&(w2->cache_lock));
+   e = (w2->cache) ? w2->cache[entry] : NULL;
+   if (e)
+     {
+        _lru_unlink(w2, e);
+        _lru_push(w2, e);
+        e->refs++;
+     }
+   pthread_mutex_unlock(&(w2->cache_lock));
+
+   if (e) WAR2_VERBOSE(w2, 2, "Entry %u found in the cache", entry);
+   return e;
+}
+
+War2_Entry *
+war2_entry_get(War2_Data    *w2,
+               unsigned int  entry)
+{
+   War2_Entry *e;
+   unsigned char *data;
+   size_t size;
+
+   if (!w2) DIE_RETURN(NULL, "Invalid inputs");
+   if (entry >= w2->entries_count)
+     DIE_RETURN(NULL, "Invalid entry [%u]. Entries range is: [0 ; %u].",
+                entry, w2->entries_count - 1);
+
+   e = war2_cache_lookup(w2, entry);
+   if (e) return e;
+
+   data = war2_entry_decode(w2, entry, &size);
+   if (!data) return NULL;
+
+   e = calloc(1, sizeof(*e));
+   if (!e)
+     {
+        free(data);
+        DIE_RETURN(NULL, "Failed to allocate memory");
+     }
+   e->data = data;
+   e->size = size;
+   e->id = entry;
+   e->refs = 1;
+
+   pthread_mutex_lock(&(w2->cache_lock));
+
+   /* Entries larger than the whole budget are not kept */
+   if ((w2->cache_budget == 0) || (size > w2->cache_budget))
+     goto end;
+
+   if (!w2->cache)
+     {
+        w2->cache = calloc(w2->entries_count, sizeof(War2_Entry *));
+        if (!w2->cache) goto end;
+     }
+
+   /* Another thread may have decoded it in the meantime */
+   if (w2->cache[entry])
+     {
+        _entry_free(e);
+        e = w2->cache[entry];
+        _lru_unlink(w2, e);
+        _lru_push(w2, e);
+        e->refs++;
+        goto end;
+     }
+
+   e->w2 = w2;
+   w2->cache[entry] = e;
+   w2->cache_size += size;
+   _lru_push(w2, e);
+   _cache_trim(w2);
+
+end:
+   pthread_mutex_unlock(&(w2->cache_lock));
+   return e;
+}
+
+void
+war2_entry_unref(War2_Entry *e)
+{
+   War2_Data *w2;
+
+   if (!e) return;
+
+   /* A referenced entry is not evicted, so 'w2' cannot change under us.
+    * Entries out of the cache are only shared after war2_close(). */
+   w2 = e->w2;
+   if (!w2)
+     {
+        if (__atomic_sub_fetch(&(e->refs), 1, __ATOMIC_ACQ_REL) == 0)
+          _entry_free(e);
+        return;
+     }
+
+   pthread_mutex_lock(&(w2->cache_lock));
+   if (e->refs == 0)
+     ERR("Entry %u is not referenced", e->id);
+   else if (--e->refs == 0)
+     _cache_trim(w2); /* It may have been kept over the budget */
+   pthread_mutex_unlock(&(w2->cache_lock));
+}
+
+void
+war2_cache_budget_set(War2_Data *w2,
+                      size_t     budget)
+{
+   if (!w2) return;
+   pthread_mutex_lock(&(w2->cache_lock));
+   w2->cache_budget = budget;
+   _cache_trim(w2);
+   pthread_mutex_unlock(&(w2->cache_lock));
+}
+
+void
+war2_cache_free(War2_Data *w2)
+{
+   War2_Entry *e, *next;
+
+   /* Referenced entries outlive the cache */
+   for (e = w2->lru_first; e; e = next)
+     {
+        next = e->next;
+        e->prev = NULL;
+        e->next = NULL;
+        e->w2 = NULL;
+        if (e->refs == 0) _entry_free(e);
+     }
+
+   free(w2->cache);
+   w2->cache = NULL;
+   w2->lru_first = NULL;
+   w2->lru_last = NULL;
+   w2->cache_size = 0;
+}
@@ -0,0 +1,265 @@
+/*
+ * extract.c
+ * libwar2
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "war2_private.h"
+#include <unistd.h>
+
+/*
+ * Workers claim the entries in order from a shared counter. Before
+ * decoding an entry, a worker reserves its uncompressed size (from the
+ * header) and waits while the entries that were not consumed yet hold
+ * more than 'mem_max'. When the results are ordered, the worker that
+ * completes the next expected entry delivers it, and all the following
+ * ones that are ready.
+ */
+
+typedef struct
+{
+   unsigned char *data;
+   size_t         size;
+   size_t         reserved;
+   Pud_Bool       done;
+} Pending;
+
+typedef struct
+{
+   War2_Data       *w2;
+   War2_Extract_Cb  cb;
+   void            *data;
+   Pud_Bool         ordered;
+   size_t           mem_max;
+
+   pthread_mutex_t  lock;
+   pthread_cond_t   cond;
+   unsigned int     first;
+   unsigned int     next; /* Next entry to claim */
+   unsigned int     end;
+   size_t           held; /* Reserved by the entries not consumed yet */
+
+   /* Ordered delivery */
+   Pending         *pending;
+   unsigned int     deliver; /* Next entry to deliver */
+   Pud_Bool         delivering;
+
+   pthread_mutex_t  cb_lock;
+} Extract;
+
+typedef struct
+{
+   Extract   *extract;
+   pthread_t  thread;
+} Worker;
+
+static size_t
+_entry_size(const War2_Data *w2,
+            unsigned int     entry)
+{
+   const unsigned char *const p = w2->entries[entry];
+   uint32_t l;
+
+   /* Invalid entries are reported by their extraction */
+   if ((!p) || ((size_t)(w2->mem_map + w2->mem_map_size - p) < sizeof(l)))
+     return 0;
+   memcpy(&l, p, sizeof(l));
+   return l & 0x00ffffff;
+}
+
+static void
+_ordered_deliver(Extract       *x,
+                 unsigned int   entry,
+                 unsigned char *data,
+                 size_t         size,
+                 size_t         reserved)
+{
+   War2_Extract_Result res;
+   Pending *p;
+
+   pthread_mutex_lock(&(x->lock));
+   p = &(x->pending[entry - x->first]);
+   p->data = data;
+   p->size = size;
+   p->reserved = reserved;
+   p->done = PUD_TRUE;
+
+   /* Another worker is delivering: it will find this one */
+   if (x->delivering)
+     {
+        pthread_mutex_unlock(&(x->lock));
+        return;
+     }
+
+   x->delivering = PUD_TRUE;
+   while ((x->deliver < x->end) && (x->pending[x->deliver - x->first].done))
+     {
+        p = &(x->pending[x->deliver - x->first]);
+        res.entry = x->deliver;
+        res.data = p->data;
+        res.size = p->size;
+
+        pthread_mutex_unlock(&(x->lock));
+        x->cb(x->data, &res);
+        pthread_mutex_lock(&(x->lock));
+
+        x->held -= p->reserved;
+        x->deliver++;
+        pthread_cond_broadcast(&(x->cond));
+     }
+   x->delivering = PUD_FALSE;
+   pthread_mutex_unlock(&(x->lock));
+}
+
+static void *
+_worker_run(void *data)
+{
+   Worker *const w = data;
+   Extract *const x = w->extract;
+   War2_Extract_Result res;
+   unsigned int entry;
+   size_t reserved;
+
+   for (;;)
+     {
+        pthread_mutex_lock(&(x->lock));
+        if (x->next >= x->end)
+          {
+             pthread_mutex_unlock(&(x->lock));
+             break;
+          }
+        entry = x->next++;
+        reserved = _entry_size(x->w2, entry);
+
+        /* Nothing held, or the next entry to deliver: waiting would
+         * never end */
+        while ((x->mem_max > 0) && (x->held > 0) &&
+               (x->held + reserved > x->mem_max) &&
+               (!((x->ordered) && (entry == x->deliver))))
+          pthread_cond_wait(&(x->cond), &(x->lock));
+        x->held += reserved;
+        pthread_mutex_unlock(&(x->lock));
+
+        /* The cache is bypassed: the callback owns the results */
+        res.entry = entry;
+        res.data = war2_entry_decode(x->w2, entry, &(res.size));
+
+        if (x->ordered)
+          _ordered_deliver(x, entry, res.data, res.size, reserved);
+        else
+          {
+             pthread_mutex_lock(&(x->cb_lock));
+             x->cb(x->data, &res);
+             pthread_mutex_unlock(&(x->cb_lock));
+
+             pthread_mutex_lock(&(x->lock));
+             x->held -= reserved;
+             pthread_cond_broadcast(&(x->cond));
+             pthread_mutex_unlock(&(x->lock));
+          }
+     }
+
+   return NULL;
+}
+
+Pud_Bool
+war2_entries_extract(War2_Data       *w2,
+                     unsigned int     first,
+                     unsigned int     count,
+                     unsigned int     workers,
+                     Pud_Bool         ordered,
+                     size_t           mem_max,
+                     War2_Extract_Cb  cb,
+                     void            *data)
+{
+   Extract x;
+   Worker *w;
+   unsigned int i, started;
+   long cpus;
+   int err;
+
+   if ((!w2) || (!cb)) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   if ((first > w2->entries_count) || (count > w2->entries_count - first))
+     DIE_RETURN(PUD_FALSE, "Invalid entries [%u ; %u[. Entries range is: [0 ; %u].",
+                first, first + count, w2->entries_count - 1);
+   if (count == 0) return PUD_TRUE;
+
+   if (workers == 0)
+     {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (cpus > 0) ? (unsigned int)cpus : 1;
+     }
+   if (workers > count) workers = count;
+
+   memset(&x, 0, sizeof(x));
+   x.w2 = w2;
+   x.cb = cb;
+   x.data = data;
+   x.ordered = ordered;
+   x.mem_max = mem_max;
+   x.first = first;
+   x.next = first;
+   x.end = first + count;
+   x.deliver = first;
+
+   if (ordered)
+     {
+        x.pending = calloc(count, sizeof(Pending));
+        if (!x.pending) DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+     }
+   w = calloc(workers, sizeof(Worker));
+   if (!w)
+     {
+        free(x.pending);
+        DIE_RETURN(PUD_FALSE, "Failed to allocate memory");
+     }
+
+   pthread_mutex_init(&(x.lock), NULL);
+   pthread_mutex_init(&(x.cb_lock), NULL);
+   pthread_cond_init(&(x.cond), NULL);
+   for (i = 0; i < workers; i++)
+     w[i].extract = &x;
+
+   /* No need for threads */
+   if (workers == 1)
+     started = 0;
+   else
+     {
+        for (started = 0; started < workers; started++)
+          {
+             err = pthread_create(&(w[started].thread), NULL, _worker_run, &(w[started]));
+             if (err != 0)
+               {
+                  ERR("Failed to create worker thread: %s", strerror(err));
+                  break;
+               }
+          }
+     }
+
+   /* If no worker started, the work is done here */
+   if (started == 0)
+     _worker_run(&(w[0]));
+   for (i = 0; i < started; i++)
+     pthread_join(w[i].thread, NULL);
+
+   pthread_cond_destroy(&(x.cond));
+   pthread_mutex_destroy(&(x.cb_lock));
+   pthread_mutex_destroy(&(x.lock));
+   free(x.pending);
+   free(w);
+
+   return PUD_TRUE;
+}
+
+Pud_Bool
+war2_entries_extract_all(War2_Data       *w2,
+                         unsigned int     workers,
+                         Pud_Bool         ordered,
+                         War2_Extract_Cb  cb,
+                         void            *data)
+{
+   if (!w2) DIE_RETURN(PUD_FALSE, "Invalid inputs");
+   return war2_entries_extract(w2, 0, w2->entries_count, workers, ordered,
+                               WAR2_EXTRACT_MEM_DEFAULT, cb, data);
+}
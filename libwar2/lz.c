@@ -0,0 +1,147 @@
+/*
+ * lz.c
+ * libwar2
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "war2_private.h"
+
+/*
+ * Compressed entries are a LZ77 variant (see wargus). A flag byte rules
+ * the 8 next items, starting from its lowest bit:
+ *  - 1: a literal byte;
+ *  - 0: a 16-bits little endian word. Its 12 low bits are the position of
+ *    the match in a 4 KiB ring of the output (zeroed at start), and its 4
+ *    high bits are the length of the match minus 3.
+ *
+ * The ring holds the last 4096 output bytes, so a match at ring position
+ * 'w' is at distance ((o - w) & 0xfff) of the output position 'o' (4096
+ * when it is 0), and is copied from the output itself. Positions before
+ * the start of the output are zeros.
+ */
+
+/* Worst case of input for 'ulen' bytes of output: all literals, except a
+ * final 1-byte match, plus the flag bytes */
+#define LZ_INPUT_MAX(ulen) ((ulen) + ((ulen) / 8) + 4)
+
+static inline void
+_match_copy(unsigned char *out,
+            size_t         o,
+            size_t         dist,
+            size_t         len)
+{
+   const unsigned char *src;
+   unsigned char *dst;
+   size_t k, zeros;
+
+   /* Before the start of the output, the ring is made of zeros */
+   if (dist > o)
+     {
+        zeros = dist - o;
+        if (zeros > len) zeros = len;
+        memset(out + o, 0, zeros);
+        o += zeros;
+        len -= zeros;
+        if (len == 0) return;
+     }
+
+   dst = out + o;
+   src = dst - dist;
+   if (dist >= len)
+     memcpy(dst, src, len);
+   else if (dist >= 8)
+     {
+        /* Overlapping, but by at least a word */
+        for (k = 0; k + 8 <= len; k += 8)
+          memcpy(dst + k, src + k, 8);
+        for (; k < len; k++)
+          dst[k] = src[k];
+     }
+   else
+     {
+        /* Runs of a short pattern */
+        for (k = 0; k < len; k++)
+          dst[k] = src[k];
+     }
+}
+
+/*
+ * When 'checked' is false, the input is known to be large enough for the
+ * worst case, so it is never checked. It must be inlined for the compiler
+ * to generate both.
+ */
+__attribute__((always_inline))
+static inline Pud_Bool
+_lz_decode(const unsigned char *in,
+           size_t               in_size,
+           unsigned char       *out,
+           size_t               ulen,
+           Pud_Bool             checked)
+{
+   const unsigned char *const in_end = in + in_size;
+   size_t o = 0, len, dist, run;
+   unsigned int bits, left;
+   uint16_t w;
+
+#define NEED(n_) \
+   do { \
+      if (checked && ((size_t)(in_end - in) < (size_t)(n_))) \
+        DIE_RETURN(PUD_FALSE, "Read outside of memory map!"); \
+   } while (0)
+
+   while (o < ulen)
+     {
+        NEED(1);
+        bits = *(in++);
+        left = 8;
+
+        while ((left > 0) && (o < ulen))
+          {
+             if (bits & 1)
+               {
+                  /* A run of literals is a single copy. Bits above the
+                   * 'left' ones are zeros, so the run stops there. */
+                  run = __builtin_ctz(~bits);
+                  if (run > ulen - o) run = ulen - o;
+                  NEED(run);
+                  memcpy(out + o, in, run);
+                  in += run;
+                  o += run;
+                  bits >>= run;
+                  left -= run;
+               }
+             else
+               {
+                  NEED(2);
+                  w = in[0] | (in[1] << 8);
+                  in += 2;
+                  len = (w >> 12) + 3;
+                  dist = (o - (w & 0x0fff)) & 0x0fff;
+                  if (dist == 0) dist = 0x1000;
+                  if (len > ulen - o) len = ulen - o;
+                  _match_copy(out, o, dist, len);
+                  o += len;
+                  bits >>= 1;
+                  left--;
+               }
+          }
+     }
+
+#undef NEED
+
+   return PUD_TRUE;
+}
+
+Pud_Bool
+war2_lz_decode(const unsigned char *in,
+               size_t               in_size,
+               unsigned char       *out,
+               size_t               ulen)
+{
+   /* One bounds check for most entries: only the last ones of a file
+    * may lack room for the worst case */
+   if (in_size >= LZ_INPUT_MAX(ulen))
+     return _lz_decode(in, in_size, out, ulen, PUD_FALSE);
+   return _lz_decode(in, in_size, out, ulen, PUD_TRUE);
+}
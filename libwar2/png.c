@@ -11,18 +11,25 @@
 # include <png.h>
 #endif
 
-Pud_Bool
-war2_png_write(const char          *file,
-               int                  w,
-               int                  h,
-               const unsigned char *data)
-{
 #if HAVE_PNG
+static Pud_Bool
+_png_write(const char          *file,
+           int                  w,
+           int                  h,
+           const unsigned char *data,
+           const Pud_Color     *palette,
+           unsigned int         count)
+{
    FILE *f;
    int i;
    png_structp png_ptr;
    png_infop info_ptr;
    png_bytepp row_pointers;
+   png_color plte[256];
+   png_byte trns[256];
+   Pud_Bool has_trns = PUD_FALSE;
+   unsigned int k;
+   const int bpp = (palette) ? 1 : 4;
 
    f = fopen(file, "wb");
    if (!f) DIE_RETURN(PUD_FALSE, "Failed to open [%s]", file);
@@ -35,15 +42,34 @@ war2_png_write(const char          *file,
 
    png_init_io(png_ptr, f);
 
-   png_set_IHDR(png_ptr, info_ptr, w, h, 8, PNG_COLOR_TYPE_RGBA,
-                PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
-                PNG_FILTER_TYPE_BASE);
+   if (palette)
+     {
+        png_set_IHDR(png_ptr, info_ptr, w, h, 8, PNG_COLOR_TYPE_PALETTE,
+                     PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
+                     PNG_FILTER_TYPE_BASE);
+        for (k = 0; k < count; k++)
+          {
+             plte[k].red = palette[k].r;
+             plte[k].green = palette[k].g;
+             plte[k].blue = palette[k].b;
+             trns[k] = palette[k].a;
+             if (trns[k] != 0xff) has_trns = PUD_TRUE;
+          }
+        png_set_PLTE(png_ptr, info_ptr, plte, count);
+        /* Alpha is only stored when the palette is not opaque */
+        if (has_trns)
+          png_set_tRNS(png_ptr, info_ptr, trns, count, NULL);
+     }
+   else
+     png_set_IHDR(png_ptr, info_ptr, w, h, 8, PNG_COLOR_TYPE_RGBA,
+                  PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
+                  PNG_FILTER_TYPE_BASE);
    png_write_info(png_ptr, info_ptr);
 
    row_pointers = malloc(h * sizeof(unsigned char *));
    if (!row_pointers) DIE_GOTO(errf, "Failed to allocate memory");
    for (i = 0; i < h; i++)
-     row_pointers[i] = (png_bytep)(&(data[i * w * 4]));
+     row_pointers[i] = (png_bytep)(&(data[i * w * bpp]));
 
    png_write_image(png_ptr, row_pointers);
    png_write_end(png_ptr, NULL);
@@ -58,7 +84,39 @@ errf:
 err:
    fclose(f);
    return PUD_FALSE;
+}
+#endif
 
+Pud_Bool
+war2_png_write(const char          *file,
+               int                  w,
+               int                  h,
+               const unsigned char *data)
+{
+#if HAVE_PNG
+   return _png_write(file, w, h, data, NULL, 0);
+#else
+   (void) file;
+   (void) w;
+   (void) h;
+   (void) data;
+   return PUD_FALSE;
+#endif
+}
+
+Pud_Bool
+war2_png_indexed_write(const char          *file,
+                       int                  w,
+                       int                  h,
+                       const unsigned char *data,
+                       const Pud_Color     *palette,
+                       unsigned int         count)
+{
+   if ((!palette) || (count == 0) || (count > 256))
+     DIE_RETURN(PUD_FALSE, "Invalid palette of %u colors", count);
+
+#if HAVE_PNG
+   return _png_write(file, w, h, data, palette, count);
 #else
    (void) file;
    (void) w;
@@ -14,10 +14,10 @@ war2_mem_map_ok(War2_Data *w2)
 }
 
 void
-war2_palette_convert(unsigned char *ptr,
-                     Pud_Color      palette[256])
+war2_palette_convert(const unsigned char *ptr,
+                     Pud_Color            palette[256])
 {
-   unsigned char *p;
+   const unsigned char *p;
    unsigned int i;
 
    /* I don't know why this is the bitshift needed (no doc so no explaination)
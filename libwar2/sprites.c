@@ -102,13 +102,14 @@ _sprites_entries_parse(War2_Data                *w2,
                        const unsigned int       *entries,
                        War2_Sprites_Decode_Func  func)
 {
-   unsigned char *ptr;
+   War2_Entry *e;
+   const unsigned char *ptr, *rows, *o;
    uint16_t count, i, oline, max_w, max_h;
    uint8_t x, y, w, h, c;
    uint32_t dstart;
    size_t size, max_size;
    unsigned int offset, l, pcount, k;
-   unsigned char *img = NULL, *pimg, *rows, *o;
+   unsigned char *img = NULL, *pimg;
    Pud_Color *img_rgba = NULL;
 
    /* If no callback has been specified, do nothing */
@@ -119,16 +120,17 @@ _sprites_entries_parse(War2_Data                *w2,
      }
 
    /* Palette */
-   ptr = war2_palette_extract(w2, entries[0]);
-   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to get palette");
-   war2_palette_convert(ptr, ud->palette);
-   free(ptr);
+   e = war2_palette_get(w2, entries[0]);
+   if (!e) DIE_RETURN(PUD_FALSE, "Failed to get palette");
+   war2_palette_convert(e->data, ud->palette);
+   war2_entry_unref(e);
 
    /* Set alpha */
    ud->palette[PALETTE_ALPHA].a = 0x00;
 
-   ptr = war2_entry_extract(w2, entries[1], &size);
-   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to extract entry");
+   e = war2_entry_get(w2, entries[1]);
+   if (!e) DIE_RETURN(PUD_FALSE, "Failed to extract entry");
+   ptr = e->data;
 
    memcpy(&count, &(ptr[0]), sizeof(uint16_t));
    memcpy(&max_w, &(ptr[2]), sizeof(uint16_t));
@@ -196,7 +198,7 @@ _sprites_entries_parse(War2_Data                *w2,
 
    free(img_rgba);
    free(img);
-   free(ptr);
+   war2_entry_unref(e);
 
    return PUD_TRUE;
 }
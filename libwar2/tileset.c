@@ -10,9 +10,9 @@
 static void
 _tile_decode(War2_Tileset_Descriptor  *ts,
              War2_Tileset_Decode_Func  func,
-             unsigned char            *ptr,
-             unsigned char            *data,
-             unsigned char            *map,
+             const unsigned char      *ptr,
+             const unsigned char      *data,
+             const unsigned char      *map,
              uint16_t                  tile)
 {
    /* Lookup table (flip table): 0=>7, 1=>6, 2=>5, ... 7=>0
@@ -71,8 +71,8 @@ _ts_entries_parse(War2_Data                *w2,
                   const unsigned int       *entries,
                   War2_Tileset_Decode_Func  func)
 {
-   unsigned char *ptr, *data, *map;
-   size_t size, map_size;
+   War2_Entry *pal, *e_ptr, *e_data, *e_map;
+   const unsigned char *ptr, *data, *map;
    int tile;
    int i, j, k;
 
@@ -84,29 +84,33 @@ _ts_entries_parse(War2_Data                *w2,
      }
 
    /* Extract palette - 256x3 */
-   ptr = war2_palette_extract(w2, entries[0]);
-   if (!ptr) DIE_RETURN(PUD_FALSE, "Failed to get palette");
-   war2_palette_convert(ptr, ts->palette);
-   free(ptr);
-
-   /* Get minitiles info */
-   ptr = war2_entry_extract(w2, entries[1], &size);
-   if (!ptr)
+   pal = war2_palette_get(w2, entries[0]);
+   if (!pal) DIE_RETURN(PUD_FALSE, "Failed to get palette");
+   war2_palette_convert(pal->data, ts->palette);
+   war2_entry_unref(pal);
+
+   /* Get minitiles info. They are cached, so decoding the tileset again
+    * does not decompress them again. */
+   e_ptr = war2_entry_get(w2, entries[1]);
+   if (!e_ptr)
      DIE_RETURN(PUD_FALSE, "Failed to extract entry minitile info [%i]", entries[1]);
-   data = war2_entry_extract(w2, entries[2], NULL);
-   if (!data)
+   e_data = war2_entry_get(w2, entries[2]);
+   if (!e_data)
      {
-        free(ptr);
+        war2_entry_unref(e_ptr);
         DIE_RETURN(PUD_FALSE, "Failed to extract entry minitile data [%i]", entries[2]);
      }
-   map = war2_entry_extract(w2, entries[3], &map_size);
-   if (!map)
+   e_map = war2_entry_get(w2, entries[3]);
+   if (!e_map)
      {
-        free(ptr);
-        free(data);
+        war2_entry_unref(e_ptr);
+        war2_entry_unref(e_data);
         DIE_RETURN(PUD_FALSE, "Failed to extract entry map [%i]", entries[3]);
      }
-   ts->tiles = size / 32;
+   ptr = e_ptr->data;
+   data = e_data->data;
+   map = e_map->data;
+   ts->tiles = e_ptr->size / 32;
 
    for (j = 0x1; j <= 0xc; j++)
      {
@@ -171,9 +175,9 @@ _ts_entries_parse(War2_Data                *w2,
      }
 #endif
 
-   free(ptr);
-   free(data);
-   free(map);
+   war2_entry_unref(e_ptr);
+   war2_entry_unref(e_data);
+   war2_entry_unref(e_map);
 
    return PUD_TRUE;
 }
@@ -37,10 +37,13 @@ war2_open(const char *file,
    w2 = calloc(1, sizeof(War2_Data));
    if (!w2) DIE_GOTO(err, "Failed to allocate memory");
    war2_verbosity_set(w2, verbosity);
+   w2->cache_budget = WAR2_CACHE_BUDGET_DEFAULT;
+   if (pthread_mutex_init(&(w2->cache_lock), NULL) != 0)
+     DIE_GOTO(err_free, "Failed to create the cache lock");
 
    /* Map file */
    w2->mem_map = pud_mmap(file, &(w2->mem_map_size));
-   if (!w2->mem_map) DIE_GOTO(err_free, "Failed to map file");
+   if (!w2->mem_map) DIE_GOTO(err_destroy, "Failed to map file");
    w2->ptr = w2->mem_map;
    WAR2_VERBOSE(w2, 1, "File [%s] mapped size is %zu bytes", file, w2->mem_map_size);
 
@@ -91,6 +94,8 @@ err_free_all:
    free(w2->entries);
 err_unmap:
    pud_munmap(w2->mem_map, w2->mem_map_size);
+err_destroy:
+   pthread_mutex_destroy(&(w2->cache_lock));
 err_free:
    free(w2);
 err:
@@ -115,33 +120,58 @@ war2_palette_extract(War2_Data    *w2,
    return ptr;
 }
 
-
-unsigned char *
-war2_entry_extract(War2_Data    *w2,
-                   unsigned int  entry,
-                   size_t       *size_ret)
+static const unsigned char *
+_entry_header(War2_Data    *w2,
+              unsigned int  entry,
+              uint32_t     *ulen,
+              int          *flags,
+              size_t       *avail)
 {
-   unsigned char buf[4096];
-   unsigned char *ptr = NULL, *p, *e;
-   uint32_t l, ulen;
-   uint16_t w;
-   uint8_t bits, b;
-   int flags, i, j, bi = 0;
+   const unsigned char *p, *end;
+   uint32_t l;
 
    /* Check the entry is in the range */
    if (entry >= w2->entries_count)
      DIE_RETURN(NULL, "Invalid entry [%i]. Entries range is: [0 ; %u].",
                 entry, w2->entries_count - 1);
+   if (!w2->entries[entry])
+     DIE_RETURN(NULL, "Entry %i has an invalid offset", entry);
 
-   /* Go at entry */
-   w2->ptr = w2->entries[entry];
+   /* Go at entry. The cursor is local, so that concurrent extractions
+    * do not disturb each other. */
+   p = w2->entries[entry];
+   end = w2->mem_map + w2->mem_map_size;
 
    /* Uncompressed length (3 bytes) & Flags (1 byte) */
-   l = READ32(w2, FAIL(NULL));
-   flags = l >> 24;
-   ulen = l & 0x00ffffff;
+   if ((size_t)(end - p) < sizeof(l))
+     DIE_RETURN(NULL, "Read outside of memory map!");
+   memcpy(&l, p, sizeof(l));
+   p += sizeof(l);
+   *flags = l >> 24;
+   *ulen = l & 0x00ffffff;
    WAR2_VERBOSE(w2, 2, "Entry %i: uncompressed length: %i. Flags: 0x%02x",
-                entry, ulen, flags);
+                entry, *ulen, *flags);
+
+   /* The data of the entry is at most the rest of the file */
+   *avail = end - p;
+
+   return p;
+}
+
+unsigned char *
+war2_entry_decode(War2_Data    *w2,
+                  unsigned int  entry,
+                  size_t       *size_ret)
+{
+   const unsigned char *p;
+   unsigned char *ptr = NULL;
+   uint32_t ulen;
+   size_t avail;
+   int flags;
+
+   if (size_ret) *size_ret = 0;
+   p = _entry_header(w2, entry, &ulen, &flags, &avail);
+   if (!p) return NULL;
 
    /* Output entry will always be duplicated */
    ptr = malloc(ulen);
@@ -150,45 +180,13 @@ war2_entry_extract(War2_Data    *w2,
    switch (flags)
      {
       case 0x00: // Uncompressed
-         memcpy(ptr, w2->ptr, ulen);
+         if (ulen > avail) DIE_GOTO(fail, "Read outside of memory map!");
+         memcpy(ptr, p, ulen);
          break;
 
       case 0x20: // Compressed
-         memset(&(buf[0]), 0, sizeof(buf));
-         p = ptr;
-         e = ptr + ulen;
-         while (p < e)
-           {
-              bits = READ8(w2, ECHAP(fail));
-              for (i = 0; i < 8; i++)
-                {
-                   /*
-                    * XXX
-                    * I don't know what's the (de)compression method used here.
-                    * I blindly rely on the implementation of Wargus until I exactly
-                    * figure out what's going on (I'm a bit in the hurry right now).
-                    */
-                   if (bits & 1)
-                     {
-                        b = READ8(w2, ECHAP(fail));
-                        *(p++) = b;
-                        buf[bi++ & 0xfff] = b;
-                     }
-                   else
-                     {
-                        w = READ16(w2, ECHAP(fail));
-                        j = (w >> 12) + 3;
-                        w &= 0x0fff;
-                        while (j--)
-                          {
-                             buf[bi++ & 0xfff] = *(p++) = buf[w++ & 0xfff];
-                             if (p == e) break;
-                          }
-                     }
-                   if (p == e) break;
-                   bits >>= 1;
-                }
-           }
+         if (!war2_lz_decode(p, avail, ptr, ulen))
+           DIE_GOTO(fail, "Failed to decompress entry %i", entry);
          break;
 
       default:
@@ -205,10 +203,90 @@ fail:
    return NULL;
 }
 
+unsigned char *
+war2_entry_extract(War2_Data    *w2,
+                   unsigned int  entry,
+                   size_t       *size_ret)
+{
+   War2_Entry *e;
+   unsigned char *ptr;
+
+   if (size_ret) *size_ret = 0;
+   if (!w2) DIE_RETURN(NULL, "Invalid inputs");
+
+   /* The caller owns the result: a missing entry is decoded straight in
+    * it, without going through the cache. Cached ones are copied. */
+   e = war2_cache_lookup(w2, entry);
+   if (!e) return war2_entry_decode(w2, entry, size_ret);
+
+   ptr = malloc(e->size ? e->size : 1);
+   if (!ptr)
+     {
+        war2_entry_unref(e);
+        DIE_RETURN(NULL, "Failed to allocate memory");
+     }
+   memcpy(ptr, e->data, e->size);
+   if (size_ret) *size_ret = e->size;
+   war2_entry_unref(e);
+
+   return ptr;
+}
+
+const unsigned char *
+war2_entry_view(War2_Data    *w2,
+                unsigned int  entry,
+                size_t       *size_ret,
+                Pud_Bool     *owned)
+{
+   const unsigned char *p;
+   uint32_t ulen;
+   size_t avail;
+   int flags;
+
+   if (size_ret) *size_ret = 0;
+   if (owned) *owned = PUD_FALSE;
+   if ((!w2) || (!owned)) DIE_RETURN(NULL, "Invalid inputs");
+
+   p = _entry_header(w2, entry, &ulen, &flags, &avail);
+   if (!p) return NULL;
+
+   /* Uncompressed entries are read in place */
+   if (flags == 0x00)
+     {
+        if (ulen > avail) DIE_RETURN(NULL, "Read outside of memory map!");
+        if (size_ret) *size_ret = ulen;
+        return p;
+     }
+
+   p = war2_entry_decode(w2, entry, size_ret);
+   if (p) *owned = PUD_TRUE;
+   return p;
+}
+
+War2_Entry *
+war2_palette_get(War2_Data    *w2,
+                 unsigned int  entry)
+{
+   War2_Entry *e;
+
+   e = war2_entry_get(w2, entry);
+   if (!e)
+     DIE_RETURN(NULL, "Failed to extract entry palette [%u]", entry);
+   if (e->size != 768)
+     {
+        ERR("Invalid size [%zu]. Should be 256*3=768", e->size);
+        war2_entry_unref(e);
+        return NULL;
+     }
+   return e;
+}
+
 void
 war2_close(War2_Data *w2)
 {
    if (!w2) return;
+   war2_cache_free(w2);
+   pthread_mutex_destroy(&(w2->cache_lock));
    pud_munmap(w2->mem_map, w2->mem_map_size);
    free(w2->entries);
    free(w2);
@@ -9,18 +9,21 @@
 #include "pud_private.h"
 
 Pud_Bool
-pud_minimap_to_jpeg(Pud        *pud,
-                    const char *file)
+pud_minimap_to_jpeg_scaled(Pud          *pud,
+                           const char   *file,
+                           unsigned int  w,
+                           unsigned int  h)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    unsigned char *map;
    Pud_Bool chk;
 
-   map = pud_minimap_bitmap_generate(pud, NULL, PUD_PIXEL_FORMAT_RGBA);
+   map = pud_minimap_render_scaled(pud, w, h, PUD_FILTER_BOX,
+                                   PUD_PIXEL_FORMAT_RGBA, NULL);
    if (!map) DIE_RETURN(PUD_FALSE, "Failed to generate bitmap");
 
-   chk = war2_jpeg_write(file, pud->map_w, pud->map_h, map);
+   chk = war2_jpeg_write(file, w, h, map);
    free(map);
 
    if (chk)
@@ -28,3 +31,11 @@ pud_minimap_to_jpeg(Pud        *pud,
 
    return chk;
 }
+
+Pud_Bool
+pud_minimap_to_jpeg(Pud        *pud,
+                    const char *file)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+   return pud_minimap_to_jpeg_scaled(pud, file, pud->map_w, pud->map_h);
+}
@@ -10,6 +10,7 @@
 static const struct option _options[] =
 {
      {"output",   required_argument,    0, 'o'},
+     {"size",     required_argument,    0, 'z'},
      {"tile-at",  required_argument,    0, 't'},
      {"sprite",   required_argument,    0, 'S'},
      {"ppm",      no_argument,          0, 'p'},
@@ -44,6 +45,8 @@ _usage(FILE *stream)
            "                          the output's filename will the the input file plus \".jpeg\"\n"
            "    -g | --png            Outputs the minimap as a png file. If --out is not specified,\n"
            "                          the output's filename will the the input file plus \".png\"\n"
+           "    -z | --size <w>x<h>   Size of the minimap written by -p, -j or -g. Tiles are\n"
+           "                          replicated when upscaling and averaged when downscaling\n"
            "    -t | --tile-at <x,y>  Gets the tile ID at x,y\n"
            "    -R | --regm           Writes the action map\n"
            "    -Q | --sqm            Writes the movement map\n"
@@ -68,6 +71,8 @@ static struct  {
 
 static struct {
    char         *file;
+   unsigned int  w;
+   unsigned int  h;
    unsigned int  ppm     : 1;
    unsigned int  jpeg    : 1;
    unsigned int  png     : 1;
@@ -209,7 +214,7 @@ main(int    argc,
    /* Getopt */
    while (1)
      {
-        c = getopt_long(argc, argv, "o:pjsS:hgWPRQvt:", _options, &opt_idx);
+        c = getopt_long(argc, argv, "o:z:pjsS:hgWPRQvt:", _options, &opt_idx);
         if (c == -1) break;
 
         switch (c)
@@ -274,6 +279,12 @@ main(int    argc,
               print.enabled = 1;
               break;
 
+           case 'z':
+              if ((sscanf(optarg, "%ux%u", &out.w, &out.h) != 2) ||
+                  (out.w == 0) || (out.h == 0))
+                ABORT(1, "Invalid size [%s]. Expected <w>x<h>", optarg);
+              break;
+
            default:
               return 1;
           }
@@ -318,7 +329,7 @@ main(int    argc,
           ABORT(1, "Invalid option when --war,-W is not specified");
 
         /* Open file */
-        pud = pud_open(file, PUD_OPEN_MODE_R);
+        pud = pud_open(file, PUD_OPEN_MODE_R | PUD_OPEN_MODE_VIEW);
         if (pud == NULL) ABORT(3, "Failed to create pud from [%s]", file);
 
         /* Set verbosity level */
@@ -363,20 +374,25 @@ main(int    argc,
                   out.file = strndup(buf, len);
                   if (!out.file) ABORT(2, "Failed to strdup [%s]", buf);
                }
+             if (out.w == 0)
+               {
+                  out.w = pud->map_w;
+                  out.h = pud->map_h;
+               }
 
              if (out.ppm)
                {
-                  if (!pud_minimap_to_ppm(pud, out.file))
+                  if (!pud_minimap_to_ppm_scaled(pud, out.file, out.w, out.h))
                     ABORT(4, "Failed to output [%s] to [%s]", file, out.file);
                }
              else if (out.jpeg)
                {
-                  if (!pud_minimap_to_jpeg(pud, out.file))
+                  if (!pud_minimap_to_jpeg_scaled(pud, out.file, out.w, out.h))
                     ABORT(4, "Failed to output [%s] to [%s]", file, out.file);
                }
              else if (out.png)
                {
-                  if (!pud_minimap_to_png(pud, out.file))
+                  if (!pud_minimap_to_png_scaled(pud, out.file, out.w, out.h))
                     ABORT(4, "Failed to output [%s] to [%s]", file, out.file);
                }
              else
@@ -10,18 +10,35 @@
 
 
 Pud_Bool
-pud_minimap_to_png(Pud        *pud,
-                   const char *file)
+pud_minimap_to_png_scaled(Pud          *pud,
+                          const char   *file,
+                          unsigned int  w,
+                          unsigned int  h)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
    unsigned char *map;
+   Pud_Color palette[256];
+   unsigned int count;
    Pud_Bool chk;
 
-   map = pud_minimap_bitmap_generate(pud, NULL, PUD_PIXEL_FORMAT_RGBA);
-   if (!map) DIE_RETURN(PUD_FALSE, "Failed to generate bitmap");
-
-   chk = war2_png_write(file, pud->map_w, pud->map_h, map);
+   if ((w < pud->map_w) || (h < pud->map_h))
+     {
+        /* Downscaled tiles are averaged: they are not in the palette */
+        map = pud_minimap_render_scaled(pud, w, h, PUD_FILTER_BOX,
+                                        PUD_PIXEL_FORMAT_RGBA, NULL);
+        if (!map) DIE_RETURN(PUD_FALSE, "Failed to generate bitmap");
+        chk = war2_png_write(file, w, h, map);
+     }
+   else
+     {
+        /* The minimap has few colors: store it as a palette */
+        map = pud_minimap_render_scaled(pud, w, h, PUD_FILTER_NEAREST,
+                                        PUD_PIXEL_FORMAT_INDEXED8, NULL);
+        if (!map) DIE_RETURN(PUD_FALSE, "Failed to generate bitmap");
+        count = pud_minimap_palette_get(pud, palette);
+        chk = war2_png_indexed_write(file, w, h, map, palette, count);
+     }
    free(map);
 
    if (chk)
@@ -29,3 +46,11 @@ pud_minimap_to_png(Pud        *pud,
 
    return chk;
 }
+
+Pud_Bool
+pud_minimap_to_png(Pud        *pud,
+                   const char *file)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+   return pud_minimap_to_png_scaled(pud, file, pud->map_w, pud->map_h);
+}
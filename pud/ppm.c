@@ -8,8 +8,10 @@
 #include "pud_private.h"
 
 Pud_Bool
-pud_minimap_to_ppm(Pud        *pud,
-                   const char *file)
+pud_minimap_to_ppm_scaled(Pud          *pud,
+                          const char   *file,
+                          unsigned int  w,
+                          unsigned int  h)
 {
    PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
 
@@ -17,7 +19,8 @@ pud_minimap_to_ppm(Pud        *pud,
    unsigned int i, size;
    unsigned char *map;
 
-   map = pud_minimap_bitmap_generate(pud, &size, PUD_PIXEL_FORMAT_RGBA);
+   map = pud_minimap_render_scaled(pud, w, h, PUD_FILTER_BOX,
+                                   PUD_PIXEL_FORMAT_RGBA, &size);
    if (!map) DIE_RETURN(PUD_FALSE, "Failed to generate bitmap");
 
    f = fopen(file, "w");
@@ -32,7 +35,7 @@ pud_minimap_to_ppm(Pud        *pud,
            "P3\n"
            "%i %i\n"
            "255\n",
-           pud->map_w, pud->map_h);
+           w, h);
 
    for (i = 0; i < size; i += 4)
      {
@@ -48,3 +51,11 @@ pud_minimap_to_ppm(Pud        *pud,
 
    return PUD_TRUE;
 }
+
+Pud_Bool
+pud_minimap_to_ppm(Pud        *pud,
+                   const char *file)
+{
+   PUD_SANITY_CHECK(pud, PUD_OPEN_MODE_R, PUD_FALSE);
+   return pud_minimap_to_ppm_scaled(pud, file, pud->map_w, pud->map_h);
+}
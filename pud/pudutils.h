@@ -21,6 +21,8 @@ Pud_Bool pud_jpeg_write(const char *file, int w, int h, const unsigned char *dat
 Pud_Bool pud_png_write(const char *file, int w, int h, const unsigned char *data);
 
 Pud_Bool pud_minimap_to_jpeg(Pud *pud, const char *file);
+Pud_Bool pud_minimap_to_jpeg_scaled(Pud *pud, const char *file, unsigned int w, unsigned int h);
 Pud_Bool pud_minimap_to_png(Pud *pud, const char *file);
+Pud_Bool pud_minimap_to_png_scaled(Pud *pud, const char *file, unsigned int w, unsigned int h);
 
 #endif /* ! _PUDUTILS_H_ */
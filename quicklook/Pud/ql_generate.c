@@ -7,6 +7,9 @@
 
 #include "ql_generate.h"
 
+/* Maps are square: previews are drawn at 512x512 */
+#define PREVIEW_SIZE 512
+
 
 static CFDictionaryRef
 _properties_new(const char *url_str,
@@ -32,31 +35,43 @@ _properties_new(const char *url_str,
     return dict;
 }
 
+static void
+_bitmap_free(void       *info,
+             const void *data,
+             size_t      size)
+{
+    free((void *)data);
+}
+
 static CGImageRef
-_pud_to_image(Pud *pud)
+_pud_to_image(Pud          *pud,
+              unsigned int  w,
+              unsigned int  h)
 {
     CGImageRef img;
     CGColorSpaceRef colorspace;
     CGDataProviderRef data_provider;
     unsigned char *map;
-    int map_size;
+    unsigned int map_size;
     
-    map = pud_minimap_bitmap_generate(pud, &map_size);
+    /* Rendered directly at the requested size */
+    map = pud_minimap_render_scaled(pud, w, h, PUD_FILTER_BOX,
+                                    PUD_PIXEL_FORMAT_RGBA, &map_size);
     if (NULL == map) {
         fprintf(stderr, "*** Failed to generate bitmap\n");
         return NULL;
     }
     
+    /* The bitmap is not copied: it is released with the image */
     colorspace = CGColorSpaceCreateDeviceRGB();
-    data_provider = CGDataProviderCreateWithData(NULL, map, map_size, NULL);
+    data_provider = CGDataProviderCreateWithData(NULL, map, map_size, _bitmap_free);
     
-    img = CGImageCreate(pud->map_w, pud->map_h, 8, 8 * 4, pud->map_w * 4, colorspace,
+    img = CGImageCreate(w, h, 8, 8 * 4, w * 4, colorspace,
                         kCGBitmapByteOrderDefault | kCGImageAlphaPremultipliedLast,
                         data_provider, NULL, false, kCGRenderingIntentDefault);
     
     CGDataProviderRelease(data_provider);
     CGColorSpaceRelease(colorspace);
-    free(map);
     
     return img;
 }
@@ -74,6 +89,7 @@ ql_generate(CFURLRef              url,
     CGRect rect;
     CFDictionaryRef properties;
     Boolean chk;
+    unsigned int side;
     
     /* Safety checks */
     if (NULL == url) {
@@ -103,7 +119,8 @@ ql_generate(CFURLRef              url,
         (preview && !QLPreviewRequestIsCancelled(preview))) {
         
         /* Open PUD */
-        pud = pud_open(path, PUD_OPEN_MODE_R);
+        pud = pud_open(path, PUD_OPEN_MODE_R | PUD_OPEN_MODE_VIEW |
+                       PUD_OPEN_MODE_LAZY);
         if (NULL == pud) {
             fprintf(stderr, "*** Failed to open PUD at path [%s]\n", path);
             goto shutdown;
@@ -115,8 +132,15 @@ ql_generate(CFURLRef              url,
             goto close;
         }
         
-        /* Generate bitmap */
-        img = _pud_to_image(pud);
+        /* Generate bitmap, at the size of the thumbnail or the preview */
+        if (NULL != thumbnail) {
+            size = QLThumbnailRequestGetMaximumSize(thumbnail);
+            side = (size.width < size.height) ? size.width : size.height;
+        } else {
+            side = PREVIEW_SIZE;
+        }
+        if (side < 1) side = pud->map_w;
+        img = _pud_to_image(pud, side, side);
         if (NULL == img) {
             fprintf(stderr, "*** Failed to generate image for PUD at path [%s]\n", path);
             goto close;
@@ -127,8 +151,8 @@ ql_generate(CFURLRef              url,
         
         if (NULL != preview) { /*=== Preview Mode ===*/
             
-            size.height = pud->map_h;
-            size.width = pud->map_w;
+            size.height = side;
+            size.width = side;
             ctx = QLPreviewRequestCreateContext(preview, size, true, properties);
             
             rect.origin = CGPointZero;
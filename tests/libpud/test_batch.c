@@ -0,0 +1,82 @@
+#include "tests.h"
+#include <errno.h>
+
+typedef struct
+{
+   unsigned int calls;
+   unsigned int seen[8];
+   unsigned int tiles;
+   Pud_Bool     ok;
+} Batch_Check;
+
+static void
+_batch_cb(void                   *data,
+          const Pud_Batch_Result *res)
+{
+   Batch_Check *const chk = data;
+
+   chk->calls++;
+   chk->seen[res->index]++;
+
+   /* The last item does not exist */
+   if (res->index == 7)
+     {
+        if ((res->pud != NULL) || (res->error != ENOENT))
+          chk->ok = PUD_FALSE;
+        return;
+     }
+   if ((res->pud == NULL) || (res->error != 0) ||
+       (res->pud->tiles != chk->tiles))
+     chk->ok = PUD_FALSE;
+   pud_close(res->pud);
+}
+
+START_TEST(batch)
+{
+   Pud_Batch_Item items[8];
+   Batch_Check chk;
+   Pud *p;
+   void *map;
+   size_t size;
+   unsigned int i, j;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   map = pud_mmap(TESTS_CIBOLA, &size);
+   fail_if(map == NULL);
+
+   memset(items, 0, sizeof(items));
+   for (i = 0; i < 6; i++)
+     items[i].file = TESTS_CIBOLA;
+   items[6].buf = map;
+   items[6].len = size;
+   items[7].file = TESTS_BUILD_DIR"/does_not_exist.pud";
+
+   fail_if(pud_open_many(NULL, 8, PUD_OPEN_MODE_R, 0, _batch_cb, &chk) != PUD_FALSE);
+   fail_if(pud_open_many(items, 8, PUD_OPEN_MODE_R, 0, NULL, &chk) != PUD_FALSE);
+
+   /* Threaded, then inline */
+   for (i = 0; i < 2; i++)
+     {
+        memset(&chk, 0, sizeof(chk));
+        chk.ok = PUD_TRUE;
+        chk.tiles = p->tiles;
+        fail_if(pud_open_many(items, 8, PUD_OPEN_MODE_R, (i == 0) ? 3 : 1,
+                              _batch_cb, &chk) != PUD_TRUE);
+        fail_if(chk.calls != 8);
+        fail_if(chk.ok != PUD_TRUE);
+        for (j = 0; j < 8; j++)
+          fail_if(chk.seen[j] != 1);
+     }
+
+   pud_munmap(map, size);
+   pud_close(p);
+}
+END_TEST
+
+void
+test_batch(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, batch);
+}
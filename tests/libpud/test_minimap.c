@@ -0,0 +1,309 @@
+#include "tests.h"
+
+START_TEST(minimap)
+{
+   Pud *p;
+   unsigned char *rgba, *argb;
+   unsigned int rgba_size, argb_size, i, j;
+   Pud_Bool unit;
+   Pud_Color c;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+
+   rgba = pud_minimap_bitmap_generate(p, &rgba_size, PUD_PIXEL_FORMAT_RGBA);
+   argb = pud_minimap_bitmap_generate(p, &argb_size, PUD_PIXEL_FORMAT_ARGB);
+   fail_if((rgba == NULL) || (argb == NULL));
+   fail_if(rgba_size != p->tiles * 4);
+   fail_if(argb_size != rgba_size);
+
+   for (i = 0; i < p->tiles; i++)
+     {
+        /* Same pixels, red and blue swapped */
+        fail_if(rgba[i * 4 + 0] != argb[i * 4 + 2]);
+        fail_if(rgba[i * 4 + 1] != argb[i * 4 + 1]);
+        fail_if(rgba[i * 4 + 2] != argb[i * 4 + 0]);
+        fail_if(rgba[i * 4 + 3] != argb[i * 4 + 3]);
+
+        /* Tiles not covered by a unit have the color of the tile */
+        unit = PUD_FALSE;
+        for (j = 0; (j < p->units_count) && (!unit); j++)
+          {
+             const Pud_Unit_Data *const u = &(p->units[j]);
+             const unsigned int x = i % p->map_w, y = i / p->map_w;
+
+             unit = ((x >= u->x) && (x < u->x + p->unit_data[u->type].size_w) &&
+                     (y >= u->y) && (y < u->y + p->unit_data[u->type].size_h));
+          }
+        if (unit) continue;
+        c = pud_tile_to_color(p->era, p->tiles_map[i]);
+        fail_if(memcmp(&(rgba[i * 4]), &c, 4) != 0);
+     }
+
+   free(rgba);
+   free(argb);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(render)
+{
+   Pud *p;
+   unsigned char *ref, *img, *px;
+   unsigned int ref_size, i, j, count, bpp, w, h;
+   const unsigned int sentinel = 0xa5;
+   Pud_Color palette[256];
+   const Pud_Pixel_Format fmts[] = {
+      PUD_PIXEL_FORMAT_BGRA,
+      PUD_PIXEL_FORMAT_RGB24,
+      PUD_PIXEL_FORMAT_RGB565,
+      PUD_PIXEL_FORMAT_INDEXED8,
+   };
+   uint16_t rgb565;
+   size_t stride;
+   int x, y;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   ref = pud_minimap_bitmap_generate(p, &ref_size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(ref == NULL);
+   count = pud_minimap_palette_get(p, palette);
+   fail_if((count < 2) || (count > 256));
+
+   /* Each format holds the same pixels as RGBA */
+   for (i = 0; i < sizeof(fmts) / sizeof(fmts[0]); i++)
+     {
+        bpp = pud_pixel_format_bpp(fmts[i]);
+        img = pud_minimap_bitmap_generate(p, &w, fmts[i]);
+        fail_if(img == NULL);
+        fail_if(w != p->tiles * bpp);
+        for (j = 0; j < p->tiles; j++)
+          {
+             const unsigned char *const c = &(ref[j * 4]);
+
+             px = &(img[j * bpp]);
+             switch (fmts[i])
+               {
+                case PUD_PIXEL_FORMAT_BGRA:
+                   fail_if((px[0] != c[2]) || (px[1] != c[1]) ||
+                           (px[2] != c[0]) || (px[3] != c[3]));
+                   break;
+                case PUD_PIXEL_FORMAT_RGB24:
+                   fail_if(memcmp(px, c, 3) != 0);
+                   break;
+                case PUD_PIXEL_FORMAT_RGB565:
+                   memcpy(&rgb565, px, 2);
+                   fail_if(rgb565 != (((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3)));
+                   break;
+                case PUD_PIXEL_FORMAT_INDEXED8:
+                   fail_if(px[0] >= count);
+                   fail_if(memcmp(&(palette[px[0]]), c, 4) != 0);
+                   break;
+                default:
+                   break;
+               }
+          }
+        free(img);
+     }
+
+   /* Render into a larger image, with a stride and (negative) offsets */
+   w = p->map_w + 10;
+   h = p->map_h + 10;
+   stride = w * 4 + 12;
+   img = malloc(stride * h);
+   fail_if(img == NULL);
+   fail_if(pud_minimap_render(p, PUD_PIXEL_FORMAT_RGBA, NULL, w, h, stride, 0, 0) != PUD_FALSE);
+   fail_if(pud_minimap_render(p, PUD_PIXEL_FORMAT_RGBA, img, w, h, w, 0, 0) != PUD_FALSE);
+
+   for (x = -20; x <= 20; x += 13)
+     {
+        for (y = -20; y <= 20; y += 17)
+          {
+             memset(img, sentinel, stride * h);
+             fail_if(pud_minimap_render(p, PUD_PIXEL_FORMAT_RGBA, img, w, h,
+                                        stride, x, y) != PUD_TRUE);
+             for (j = 0; j < h; j++)
+               {
+                  for (i = 0; i < w; i++)
+                    {
+                       const int mx = (int)i - x, my = (int)j - y;
+
+                       px = &(img[j * stride + i * 4]);
+                       if ((mx < 0) || (my < 0) ||
+                           (mx >= (int)p->map_w) || (my >= (int)p->map_h))
+                         {
+                            fail_if((px[0] != sentinel) || (px[3] != sentinel));
+                            continue;
+                         }
+                       fail_if(memcmp(px, &(ref[(my * p->map_w + mx) * 4]), 4) != 0);
+                    }
+                  /* Padding of the stride is never touched */
+                  fail_if(img[j * stride + w * 4] != sentinel);
+               }
+          }
+     }
+
+   free(img);
+   free(ref);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(minimap_update)
+{
+   Pud *p;
+   Pud_Minimap *mm;
+   Pud_Rect rects[PUD_MINIMAP_DAMAGE_MAX];
+   const unsigned char *px;
+   unsigned char *ref;
+   unsigned int size, w, h, n;
+   size_t stride;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   mm = pud_minimap_new(p, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(mm == NULL);
+   fail_if(pud_minimap_new(p, PUD_PIXEL_FORMAT_RGBA) != NULL);
+
+   /* The first update paints the whole map */
+   n = pud_minimap_update(mm, rects);
+   fail_if(n != 1);
+   fail_if((rects[0].x != 0) || (rects[0].y != 0) ||
+           (rects[0].w != p->map_w) || (rects[0].h != p->map_h));
+   px = pud_minimap_pixels_get(mm, &w, &h, &stride);
+   ref = pud_minimap_bitmap_generate(p, &size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if((px == NULL) || (ref == NULL));
+   fail_if((w != p->map_w) || (h != p->map_h) || (stride != w * 4));
+   fail_if(memcmp(px, ref, size) != 0);
+   free(ref);
+   fail_if(pud_minimap_update(mm, rects) != 0);
+
+   /* A tile edit only damages its tile */
+   fail_if(pud_tile_set(p, 10, 20, 0x0010) != PUD_TRUE);
+   n = pud_minimap_update(mm, rects);
+   fail_if(n != 1);
+   fail_if((rects[0].x != 10) || (rects[0].y != 20) ||
+           (rects[0].w != 1) || (rects[0].h != 1));
+   ref = pud_minimap_bitmap_generate(p, &size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(ref == NULL);
+   fail_if(memcmp(pud_minimap_pixels_get(mm, NULL, NULL, NULL), ref, size) != 0);
+   free(ref);
+
+   /* Distant edits are kept apart, adjacent ones are merged */
+   pud_tile_set(p, 0, 0, 0x0010);
+   pud_tile_set(p, 100, 100, 0x0010);
+   pud_tile_set(p, 101, 100, 0x0010);
+   n = pud_minimap_update(mm, rects);
+   fail_if(n != 2);
+   fail_if((rects[1].x != 100) || (rects[1].y != 100) ||
+           (rects[1].w != 2) || (rects[1].h != 1));
+
+   /* There are never more damages than PUD_MINIMAP_DAMAGE_MAX */
+   for (n = 0; n < 2 * PUD_MINIMAP_DAMAGE_MAX; n++)
+     pud_tile_set(p, n * 7, n * 5, 0x0010);
+   n = pud_minimap_update(mm, rects);
+   fail_if((n == 0) || (n > PUD_MINIMAP_DAMAGE_MAX));
+   ref = pud_minimap_bitmap_generate(p, &size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(ref == NULL);
+   fail_if(memcmp(pud_minimap_pixels_get(mm, NULL, NULL, NULL), ref, size) != 0);
+   free(ref);
+
+   /* A new unit damages its footprint */
+   fail_if(pud_unit_add(p, 50, 60, PUD_PLAYER_RED, PUD_UNIT_GREAT_HALL, 1) < 0);
+   n = pud_minimap_update(mm, rects);
+   fail_if(n != 1);
+   fail_if((rects[0].x != 50) || (rects[0].y != 60) ||
+           (rects[0].w != 4) || (rects[0].h != 4));
+   ref = pud_minimap_bitmap_generate(p, &size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(ref == NULL);
+   fail_if(memcmp(pud_minimap_pixels_get(mm, NULL, NULL, NULL), ref, size) != 0);
+   free(ref);
+
+   /* The minimap outlives its PUD */
+   pud_close(p);
+   fail_if(pud_minimap_update(mm, rects) != 0);
+   pud_minimap_free(mm);
+}
+END_TEST
+
+START_TEST(scaled)
+{
+   Pud *p;
+   unsigned char *ref, *img, *idx;
+   unsigned int ref_size, size, x, y, k, sum;
+   const unsigned char *px;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   ref = pud_minimap_bitmap_generate(p, &ref_size, PUD_PIXEL_FORMAT_RGBA);
+   fail_if(ref == NULL);
+
+   fail_if(pud_minimap_render_scaled(p, 0, 64, PUD_FILTER_BOX,
+                                     PUD_PIXEL_FORMAT_RGBA, NULL) != NULL);
+
+   /* Same size: same image, whatever the filter */
+   img = pud_minimap_render_scaled(p, p->map_w, p->map_h, PUD_FILTER_BOX,
+                                   PUD_PIXEL_FORMAT_RGBA, &size);
+   fail_if(img == NULL);
+   fail_if(size != ref_size);
+   fail_if(memcmp(img, ref, size) != 0);
+   free(img);
+
+   /* x4: each tile becomes a 4x4 block */
+   img = pud_minimap_render_scaled(p, p->map_w * 4, p->map_h * 4,
+                                   PUD_FILTER_NEAREST, PUD_PIXEL_FORMAT_RGBA,
+                                   &size);
+   fail_if(img == NULL);
+   fail_if(size != ref_size * 16);
+   for (y = 0; y < p->map_h * 4; y++)
+     for (x = 0; x < p->map_w * 4; x++)
+       fail_if(memcmp(&(img[(y * p->map_w * 4 + x) * 4]),
+                      &(ref[((y / 4) * p->map_w + (x / 4)) * 4]), 4) != 0);
+   free(img);
+
+   /* /2: each pixel is the average of a 2x2 block */
+   img = pud_minimap_render_scaled(p, p->map_w / 2, p->map_h / 2,
+                                   PUD_FILTER_BOX, PUD_PIXEL_FORMAT_RGBA,
+                                   &size);
+   fail_if(img == NULL);
+   fail_if(size != ref_size / 4);
+   for (y = 0; y < p->map_h / 2; y++)
+     for (x = 0; x < p->map_w / 2; x++)
+       for (k = 0; k < 4; k++)
+         {
+            px = &(ref[((y * 2) * p->map_w + (x * 2)) * 4 + k]);
+            sum = px[0] + px[4] + px[p->map_w * 4] + px[p->map_w * 4 + 4];
+            fail_if(img[(y * (p->map_w / 2) + x) * 4 + k] != (sum + 2) / 4);
+         }
+   free(img);
+
+   /* Sizes that are not multiples, and indexes (never averaged) */
+   img = pud_minimap_render_scaled(p, 100, 37, PUD_FILTER_BOX,
+                                   PUD_PIXEL_FORMAT_RGB24, &size);
+   fail_if(img == NULL);
+   fail_if(size != 100 * 37 * 3);
+   free(img);
+   idx = pud_minimap_render_scaled(p, 50, 50, PUD_FILTER_BOX,
+                                   PUD_PIXEL_FORMAT_INDEXED8, &size);
+   img = pud_minimap_render_scaled(p, 50, 50, PUD_FILTER_NEAREST,
+                                   PUD_PIXEL_FORMAT_INDEXED8, NULL);
+   fail_if((idx == NULL) || (img == NULL));
+   fail_if(size != 50 * 50);
+   fail_if(memcmp(idx, img, size) != 0);
+   free(idx);
+   free(img);
+
+   free(ref);
+   pud_close(p);
+}
+END_TEST
+
+void
+test_minimap(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, minimap);
+   tcase_add_test(tc, render);
+   tcase_add_test(tc, scaled);
+   tcase_add_test(tc, minimap_update);
+}
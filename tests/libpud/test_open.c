@@ -1,6 +1,6 @@
 #include "tests.h"
-#include <pud.h>
 #include <limits.h>
+#include <unistd.h>
 
 START_TEST(open)
 {
@@ -14,8 +14,6 @@ START_TEST(open)
    const unsigned int count = sizeof(files) / sizeof(files[0]);
    unsigned int i;
 
-   fail_if(pud_init() != PUD_TRUE);
-
    /*
     * Test the result of pud_open() with:
     * - NULL file
@@ -40,13 +38,295 @@ START_TEST(open)
         else
           fail_if(p != NULL);
      }
+}
+END_TEST
+
+START_TEST(sections)
+{
+   Pud *p;
+   unsigned int i;
+   const Pud_Section absent[] = {
+      PUD_SECTION_ERAX,
+      PUD_SECTION_ALOW,
+   };
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+
+   /* All mandatory sections must be found in the directory */
+   for (i = 0; i < 20; i++)
+     {
+        if ((i == absent[0]) || (i == absent[1]))
+          continue;
+        fail_if(!pud_section_present_is(p, i));
+        fail_if(pud_section_length_get(p, i) == 0);
+        fail_if(pud_go_to_section(p, i) != pud_section_length_get(p, i));
+     }
+   for (i = 0; i < sizeof(absent) / sizeof(absent[0]); i++)
+     {
+        fail_if(pud_section_present_is(p, absent[i]));
+        fail_if(pud_go_to_section(p, absent[i]) != 0);
+     }
+
+   fail_if(pud_section_length_get(p, PUD_SECTION_DIM) != 4);
+   fail_if(pud_section_length_get(p, PUD_SECTION_MTXM) != p->tiles * 2);
+
+   /* Sections can be reached in any order */
+   fail_if(pud_go_to_section(p, PUD_SECTION_UNIT) == 0);
+   fail_if(pud_go_to_section(p, PUD_SECTION_TYPE) != 16);
+   fail_if(memcmp(p->ptr, "WAR2 MAP", 8) != 0);
+
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(damaged)
+{
+   Pud *p, *d;
+   void *map;
+   unsigned char *buf, *udta;
+   size_t size;
+   uint32_t len;
+   const size_t cut = 16;
+
+   map = pud_mmap(TESTS_CIBOLA, &size);
+   fail_if(map == NULL);
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   buf = malloc(size);
+   fail_if(buf == NULL);
+
+   /* UDTA loses a few bytes but keeps its length: it overlaps UGRD,
+    * which must still be found */
+   memcpy(buf, map, size);
+   udta = buf + p->section_dir[PUD_SECTION_UDTA].offset - 8;
+   fail_if(memcmp(udta, "UDTA", 4) != 0);
+   memmove(udta + 108, udta + 108 + cut, size - (udta + 108 + cut - buf));
+   d = pud_open_memory(buf, size - cut, PUD_OPEN_MODE_R, PUD_MEMORY_BORROW);
+   fail_if(d == NULL);
+   fail_if(!pud_section_present_is(d, PUD_SECTION_UGRD));
+   fail_if(d->tiles != p->tiles);
+   fail_if(memcmp(d->tiles_map, p->tiles_map, p->tiles * sizeof(uint16_t)) != 0);
+   fail_if(d->units_count != p->units_count);
+   pud_close(d);
+
+   /* A length beyond the end of the file */
+   memcpy(buf, map, size);
+   len = 0x54000004;
+   memcpy(buf + p->section_dir[PUD_SECTION_DIM].offset - 4, &len, sizeof(len));
+   d = pud_open_memory(buf, size, PUD_OPEN_MODE_R, PUD_MEMORY_BORROW);
+   fail_if(d == NULL);
+   fail_if((d->map_w != p->map_w) || (d->map_h != p->map_h));
+   fail_if(memcmp(d->tiles_map, p->tiles_map, p->tiles * sizeof(uint16_t)) != 0);
+   pud_close(d);
+
+   free(buf);
+   pud_close(p);
+   pud_munmap(map, size);
+}
+END_TEST
+
+START_TEST(view)
+{
+   Pud *p, *v;
+   unsigned int x, y;
+   const size_t size = sizeof(uint16_t);
+
+   /* A view cannot be written */
+   v = tests_cibola_open(PUD_OPEN_MODE_RW | PUD_OPEN_MODE_VIEW);
+   fail_if(v != NULL);
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   v = tests_cibola_open(PUD_OPEN_MODE_R | PUD_OPEN_MODE_VIEW);
+   fail_if(v == NULL);
+
+   /* A view must hold exactly the same data than a copy */
+   fail_if(v->tiles != p->tiles);
+   fail_if(v->units_count != p->units_count);
+   fail_if(memcmp(v->tiles_map, p->tiles_map, p->tiles * size) != 0);
+   fail_if(memcmp(v->movement_map, p->movement_map, p->tiles * size) != 0);
+   fail_if(memcmp(v->action_map, p->action_map, p->tiles * size) != 0);
+   fail_if(memcmp(v->oil_map, p->oil_map, p->tiles) != 0);
+   fail_if(memcmp(v->units, p->units,
+                  p->units_count * sizeof(Pud_Unit_Data)) != 0);
+   for (y = 0; y < v->map_h; y++)
+     for (x = 0; x < v->map_w; x++)
+       fail_if(pud_tile_get(v, x, y) != pud_tile_get(p, x, y));
+
+   pud_close(v);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(lazy)
+{
+   Pud *p, *l;
+   const size_t size = sizeof(uint16_t);
+
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   l = tests_cibola_open(PUD_OPEN_MODE_R | PUD_OPEN_MODE_LAZY);
+   fail_if(l == NULL);
+
+   /* Headers are available right away, but not the maps */
+   fail_if(l->tiles != p->tiles);
+   fail_if(strcmp(pud_description_get(l), pud_description_get(p)) != 0);
+   fail_if(l->tiles_map != NULL);
+   fail_if(l->units != NULL);
+
+   /* Accessors decode what they need */
+   fail_if(pud_tile_get(l, 3, 4) != pud_tile_get(p, 3, 4));
+   fail_if(memcmp(l->tiles_map, p->tiles_map, p->tiles * size) != 0);
+   fail_if(l->action_map != NULL);
+   fail_if(pud_check(l, NULL) != pud_check(p, NULL));
+   fail_if(l->units_count != p->units_count);
+   fail_if(l->starting_points != p->starting_points);
+
+   fail_if(pud_section_load(l, PUD_SECTION_REGM) != PUD_TRUE);
+   fail_if(memcmp(l->action_map, p->action_map, p->tiles * size) != 0);
+
+   pud_close(l);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(reopen)
+{
+   Pud *p, *s;
+   const char *const file = TESTS_BUILD_DIR"/reopen.pud";
+   const Pud_Open_Mode modes[] = {
+      PUD_OPEN_MODE_R,
+      PUD_OPEN_MODE_R | PUD_OPEN_MODE_LAZY,
+   };
+   unsigned int i;
+
+   /* A smaller map, with other tiles and units */
+   s = pud_open_new(file, PUD_OPEN_MODE_W);
+   fail_if(s == NULL);
+   pud_dimensions_set(s, PUD_DIMENSIONS_64_64);
+   fail_if(pud_tiles_fill_rect(s, NULL, 0x0050) != PUD_TRUE);
+   fail_if(pud_unit_add(s, 3, 4, PUD_PLAYER_RED, PUD_UNIT_PEASANT, 1) < 0);
+   fail_if(pud_save(s, file, PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   pud_close(s);
+
+   for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+     {
+        p = tests_cibola_open(modes[i]);
+        fail_if(p == NULL);
+        fail_if(pud_tile_get(p, 0, 0) == 0x0050);
+
+        /* Nothing of cibola must remain */
+        fail_if(pud_reopen(p, file, modes[i]) != PUD_TRUE);
+        fail_if((p->map_w != 64) || (p->map_h != 64) || (p->tiles != 64 * 64));
+        fail_if(pud_tile_get(p, 63, 63) != 0x0050);
+        fail_if(pud_tile_get(p, 0, 0) != 0x0050);
+        fail_if(pud_unit_at(p, 3, 4) < 0);
+        fail_if(p->units_count != 1);
+        pud_close(p);
+     }
+
+   unlink(file);
+}
+END_TEST
+
+START_TEST(memory)
+{
+   Pud *p, *m;
+   void *map;
+   unsigned char *buf, *out;
+   size_t size, out_size, buf_size;
+
+   map = pud_mmap(TESTS_CIBOLA, &size);
+   fail_if(map == NULL);
+   p = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+
+   fail_if(pud_open_memory(NULL, size, PUD_OPEN_MODE_R, PUD_MEMORY_BORROW) != NULL);
+   fail_if(pud_open_memory(map, size, PUD_OPEN_MODE_W, PUD_MEMORY_BORROW) != NULL);
+
+   /* Borrowed buffer */
+   m = pud_open_memory(map, size, PUD_OPEN_MODE_R, PUD_MEMORY_BORROW);
+   fail_if(m == NULL);
+   fail_if(m->filename != NULL);
+   fail_if(m->tag != p->tag);
+   fail_if(memcmp(m->tiles_map, p->tiles_map, p->tiles * sizeof(uint16_t)) != 0);
+
+   out = pud_write_memory(m, &out_size);
+   fail_if(out == NULL);
+   pud_close(m);
+
+   /* Owned buffer: the serialized PUD is handed over */
+   m = pud_open_memory(out, out_size, PUD_OPEN_MODE_R | PUD_OPEN_MODE_VIEW,
+                       PUD_MEMORY_OWN);
+   fail_if(m == NULL);
+   fail_if(m->units_count != p->units_count);
+   fail_if(memcmp(m->units, p->units,
+                  p->units_count * sizeof(Pud_Unit_Data)) != 0);
+   fail_if(memcmp(m->action_map, p->action_map, p->tiles * sizeof(uint16_t)) != 0);
+   fail_if(strcmp(m->description, p->description) != 0);
+
+   /* Serializing again must be stable */
+   buf = pud_write_memory(m, &buf_size);
+   fail_if(buf == NULL);
+   fail_if(buf_size != out_size);
+   fail_if(memcmp(buf, out, buf_size) != 0);
+   free(buf);
+
+   pud_close(m);
+   pud_close(p);
+   pud_munmap(map, size);
+}
+END_TEST
+
+START_TEST(arena)
+{
+   Pud *p;
+   const unsigned char *start, *end;
+
+#define IN_ARENA(ptr_) \
+   (((const unsigned char *)(ptr_) >= start) && \
+    ((const unsigned char *)(ptr_) < end))
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(p->arena.mem == NULL);
+   start = p->arena.mem;
+   end = start + p->arena.size;
+
+   /* Everything lives in one cache-aligned block */
+   fail_if(((uintptr_t)p->arena.mem % 64) != 0);
+   fail_if(!IN_ARENA(p->tiles_map));
+   fail_if(!IN_ARENA(p->movement_map));
+   fail_if(!IN_ARENA(p->action_map));
+   fail_if(!IN_ARENA(p->oil_map));
+   fail_if(!IN_ARENA(p->units));
+   fail_if(!IN_ARENA(p->filename));
+   fail_if(((uintptr_t)p->tiles_map % 64) != 0);
+   fail_if(((uintptr_t)p->units % 64) != 0);
+   fail_if(strcmp(p->filename, TESTS_CIBOLA) != 0);
+
+   /* Growing moves the array out of the arena */
+   fail_if(pud_unit_add(p, 1, 1, PUD_PLAYER_RED, PUD_UNIT_FOOTMAN, 1) < 0);
+   fail_if(IN_ARENA(p->units));
+   fail_if(p->units[p->units_count - 1].type != PUD_UNIT_FOOTMAN);
+
+#undef IN_ARENA
 
-   pud_shutdown();
+   pud_close(p);
 }
 END_TEST
 
 void
 test_open(TCase *tc)
 {
+   tests_fixture_add(tc);
    tcase_add_test(tc, open);
+   tcase_add_test(tc, sections);
+   tcase_add_test(tc, damaged);
+   tcase_add_test(tc, view);
+   tcase_add_test(tc, lazy);
+   tcase_add_test(tc, reopen);
+   tcase_add_test(tc, memory);
+   tcase_add_test(tc, arena);
 }
@@ -0,0 +1,152 @@
+#include "tests.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+START_TEST(save)
+{
+   Pud *p, *s;
+   struct stat st;
+   const char *const file = TESTS_BUILD_DIR"/saved.pud";
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+
+   /* Atomic save creates the file */
+   unlink(file);
+   fail_if(pud_save(p, file, PUD_SAVE_ATOMIC) != PUD_TRUE);
+   fail_if(stat(file, &st) != 0);
+
+   /* Replacing keeps the permissions */
+   fail_if(chmod(file, 0600) != 0);
+   pud_tag_set(p, 0xcafe);
+   fail_if(pud_save(p, file, PUD_SAVE_ATOMIC | PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   fail_if(stat(file, &st) != 0);
+   fail_if((st.st_mode & 0777) != 0600);
+
+   s = pud_open(file, PUD_OPEN_MODE_R);
+   fail_if(s == NULL);
+   fail_if(s->tag != 0xcafe);
+   fail_if(s->units_count != p->units_count);
+   pud_close(s);
+
+   unlink(file);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(patch)
+{
+   Pud *p;
+   void *map;
+   unsigned char *mem;
+   size_t size, mem_size;
+   struct stat st;
+   const char *const file = TESTS_BUILD_DIR"/patched.pud";
+
+   /* Work on a copy */
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(p->dirty != 0);
+   fail_if(pud_save(p, file, PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   pud_close(p);
+   fail_if(stat(file, &st) != 0);
+
+   p = pud_open(file, PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   pud_description_set(p, "Patched in place");
+   fail_if(pud_starting_resources_set(p, PUD_PLAYER_BLUE, 1, 2, 3) != PUD_TRUE);
+   fail_if(!pud_section_dirty_is(p, PUD_SECTION_DESC));
+   fail_if(!pud_section_dirty_is(p, PUD_SECTION_SLBR));
+   fail_if(pud_section_dirty_is(p, PUD_SECTION_MTXM));
+
+   /* Same sizes: patched in place */
+   fail_if(pud_save(p, NULL, PUD_SAVE_PATCH) != PUD_TRUE);
+   fail_if(p->dirty != 0);
+   fail_if(p->layout_stale);
+
+   /* Patching does not make the file look replaced */
+   pud_tag_set(p, 0xbeef);
+   fail_if(pud_save(p, NULL, PUD_SAVE_PATCH | PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   fail_if(p->layout_stale);
+
+   /* The file must be what a full rewrite would have produced */
+   mem = pud_write_memory(p, &mem_size);
+   fail_if(mem == NULL);
+   map = pud_mmap(file, &size);
+   fail_if(map == NULL);
+   fail_if(size != (size_t)st.st_size);
+   fail_if(size != mem_size);
+   fail_if(memcmp(map, mem, size) != 0);
+   pud_munmap(map, size);
+   free(mem);
+
+   /* UNIT grows: a full rewrite is needed */
+   fail_if(pud_unit_add(p, 1, 1, PUD_PLAYER_RED, PUD_UNIT_FOOTMAN, 1) < 0);
+   fail_if(pud_save(p, NULL, PUD_SAVE_PATCH | PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   fail_if(!p->layout_stale);
+   pud_close(p);
+
+   p = pud_open(file, PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   fail_if(strcmp(p->description, "Patched in place") != 0);
+   fail_if(p->sgld.players[PUD_PLAYER_BLUE] != 1);
+   fail_if(p->soil.players[PUD_PLAYER_BLUE] != 3);
+   fail_if(p->units[p->units_count - 1].type != PUD_UNIT_FOOTMAN);
+   pud_close(p);
+
+   unlink(file);
+}
+END_TEST
+
+START_TEST(patch_replaced)
+{
+   Pud *p;
+   struct stat st;
+   ino_t ino;
+   const char *const file = TESTS_BUILD_DIR"/replaced.pud";
+   const char *const other = TESTS_BUILD_DIR"/replaced.pud.other";
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(pud_save(p, file, PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   fail_if(pud_save(p, other, PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   pud_close(p);
+
+   /* Replaced by a file of the same size after it was opened */
+   p = pud_open(file, PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(rename(other, file) != 0);
+   pud_tag_set(p, 0xcafe);
+   fail_if(pud_save(p, NULL, PUD_SAVE_PATCH | PUD_SAVE_NO_SYNC) != PUD_TRUE);
+   fail_if(!p->layout_stale);
+   pud_close(p);
+
+   /* Atomic wins over patching */
+   p = pud_open(file, PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(stat(file, &st) != 0);
+   ino = st.st_ino;
+   pud_tag_set(p, 0xbeef);
+   fail_if(pud_save(p, NULL, PUD_SAVE_PATCH | PUD_SAVE_ATOMIC) != PUD_TRUE);
+   fail_if(!p->layout_stale);
+   fail_if(stat(file, &st) != 0);
+   fail_if(st.st_ino == ino);
+   pud_close(p);
+
+   p = pud_open(file, PUD_OPEN_MODE_R);
+   fail_if(p == NULL);
+   fail_if(p->tag != 0xbeef);
+   pud_close(p);
+
+   unlink(file);
+}
+END_TEST
+
+void
+test_save(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, save);
+   tcase_add_test(tc, patch);
+   tcase_add_test(tc, patch_replaced);
+}
@@ -0,0 +1,151 @@
+#include "tests.h"
+
+START_TEST(tiles_edit)
+{
+   Pud *p, *q;
+   Pud_Rect r;
+   uint16_t *ref, *tmp;
+   uint16_t stamp[6 * 5], lut[0x100];
+   unsigned int i, j, w;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   w = p->map_w;
+   fail_if(pud_tile_get(p, 0, 0) == 0xffff); /* Loads MTXM */
+   ref = malloc(p->tiles * sizeof(uint16_t));
+   tmp = malloc(p->tiles * sizeof(uint16_t));
+   fail_if((ref == NULL) || (tmp == NULL));
+   memcpy(ref, p->tiles_map, p->tiles * sizeof(uint16_t));
+
+   /* Fill, clipped by the map */
+   r.x = w - 10;
+   r.y = 3;
+   r.w = 50;
+   r.h = 7;
+   fail_if(pud_tiles_fill_rect(p, &r, 0x0010) != PUD_TRUE);
+   for (j = 3; j < 10; j++)
+     for (i = w - 10; i < w; i++)
+       ref[j * w + i] = 0x0010;
+   fail_if(memcmp(p->tiles_map, ref, p->tiles * sizeof(uint16_t)) != 0);
+   fail_if(!pud_section_dirty_is(p, PUD_SECTION_MTXM));
+
+   /* Blit of a raw buffer, partly out of the map */
+   for (i = 0; i < 6 * 5; i++) stamp[i] = (uint16_t)(0x0030 + i);
+   fail_if(pud_tiles_blit(p, -2, -1, stamp, 5, 5, 6) != PUD_TRUE);
+   for (j = 1; j < 5; j++)
+     for (i = 2; i < 5; i++)
+       ref[(j - 1) * w + (i - 2)] = stamp[j * 6 + i];
+   fail_if(memcmp(p->tiles_map, ref, p->tiles * sizeof(uint16_t)) != 0);
+   fail_if(pud_tiles_blit(p, 0, 0, stamp, 7, 5, 6) != PUD_FALSE);
+
+   /* Copy of overlapping areas of the same map, in both directions */
+   r.x = 10;
+   r.y = 10;
+   r.w = 40;
+   r.h = 30;
+   memcpy(tmp, ref, p->tiles * sizeof(uint16_t));
+   for (j = 0; j < r.h; j++)
+     for (i = 0; i < r.w; i++)
+       ref[(j + 13) * w + (i + 12)] = tmp[(j + 10) * w + (i + 10)];
+   fail_if(pud_tiles_copy(p, 12, 13, p, &r) != PUD_TRUE);
+   fail_if(memcmp(p->tiles_map, ref, p->tiles * sizeof(uint16_t)) != 0);
+
+   memcpy(tmp, ref, p->tiles * sizeof(uint16_t));
+   for (j = 0; j < r.h; j++)
+     for (i = 0; i < r.w; i++)
+       ref[(j + 7) * w + (i + 8)] = tmp[(j + 10) * w + (i + 10)];
+   fail_if(pud_tiles_copy(p, 8, 7, p, &r) != PUD_TRUE);
+   fail_if(memcmp(p->tiles_map, ref, p->tiles * sizeof(uint16_t)) != 0);
+
+   /* Copy from another PUD */
+   q = tests_cibola_open(PUD_OPEN_MODE_R);
+   fail_if(q == NULL);
+   fail_if(pud_tiles_copy(p, 0, 0, q, NULL) != PUD_TRUE);
+   fail_if(memcmp(p->tiles_map, q->tiles_map, p->tiles * sizeof(uint16_t)) != 0);
+   memcpy(ref, q->tiles_map, p->tiles * sizeof(uint16_t));
+   pud_close(q);
+
+   /* Remapping: tiles beyond the table are kept */
+   for (i = 0; i < 0x100; i++) lut[i] = (uint16_t)(i ^ 0x0001);
+   fail_if(pud_tiles_replace(p, NULL, lut, 0x100) != PUD_TRUE);
+   for (i = 0; i < p->tiles; i++)
+     if (ref[i] < 0x100) ref[i] ^= 0x0001;
+   fail_if(memcmp(p->tiles_map, ref, p->tiles * sizeof(uint16_t)) != 0);
+
+   free(tmp);
+   free(ref);
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(randomize)
+{
+   Pud *p, *q;
+   Pud_Random a, b;
+   uint16_t *orig;
+   unsigned int i, seen = 0, diff = 0;
+   uint32_t v;
+   uint8_t k;
+
+   /* Same seed, same sequence */
+   pud_random_seed(&a, 1234);
+   pud_random_seed(&b, 1234);
+   for (i = 0; i < 1000; i++)
+     fail_if(pud_random_next(&a) != pud_random_next(&b));
+   pud_random_seed(&b, 1235);
+   fail_if(pud_random_next(&a) == pud_random_next(&b));
+
+   for (i = 0; i < 1000; i++)
+     {
+        v = pud_random_uniform(&a, 11);
+        fail_if(v >= 11);
+        seen |= (1u << v);
+     }
+   fail_if(seen != 0x7ff);
+   fail_if(pud_random_uniform(&a, 0) != 0);
+
+   /* Variants are among the existing ones */
+   for (i = 0; i < 200; i++)
+     {
+        k = pud_random_variant_get(0x0050, &a);
+        fail_if((k == 0x3) || (k > 0xf));
+        k = pud_random_variant_get(0x0710, &a);
+        fail_if(k > 0x1);
+     }
+
+   /* Same seed, same map */
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   q = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if((p == NULL) || (q == NULL));
+   fail_if(pud_tile_get(p, 0, 0) == 0xffff); /* Loads MTXM */
+   orig = malloc(p->tiles * sizeof(uint16_t));
+   fail_if(orig == NULL);
+   memcpy(orig, p->tiles_map, p->tiles * sizeof(uint16_t));
+
+   fail_if(pud_tiles_randomize(p, NULL, 42) != PUD_TRUE);
+   fail_if(pud_tiles_randomize(q, NULL, 42) != PUD_TRUE);
+   fail_if(memcmp(p->tiles_map, q->tiles_map, p->tiles * sizeof(uint16_t)) != 0);
+   for (i = 0; i < p->tiles; i++)
+     {
+        /* The class of the tile is kept */
+        fail_if((p->tiles_map[i] & 0xfff0) != (orig[i] & 0xfff0));
+        diff += (p->tiles_map[i] != orig[i]);
+     }
+   fail_if(diff == 0);
+
+   fail_if(pud_tiles_randomize(q, NULL, 43) != PUD_TRUE);
+   fail_if(memcmp(p->tiles_map, q->tiles_map, p->tiles * sizeof(uint16_t)) == 0);
+
+   free(orig);
+   pud_close(q);
+   pud_close(p);
+}
+END_TEST
+
+void
+test_tiles(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, tiles_edit);
+   tcase_add_test(tc, randomize);
+}
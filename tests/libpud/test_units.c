@@ -0,0 +1,185 @@
+#include "tests.h"
+
+static unsigned int
+_units_in_rect_naive(const Pud      *p,
+                     const Pud_Rect *r,
+                     unsigned int   *units)
+{
+   const Pud_Unit_Data *u;
+   unsigned int i, w, h, n = 0;
+
+   for (i = 0; i < p->units_count; i++)
+     {
+        u = &(p->units[i]);
+        if ((u->x >= p->map_w) || (u->y >= p->map_h)) continue;
+        w = p->unit_data[u->type].size_w ? p->unit_data[u->type].size_w : 1;
+        h = p->unit_data[u->type].size_h ? p->unit_data[u->type].size_h : 1;
+        if ((u->x + w > r->x) && (u->x < r->x + r->w) &&
+            (u->y + h > r->y) && (u->y < r->y + r->h))
+          units[n++] = i;
+     }
+   return n;
+}
+
+START_TEST(units_index)
+{
+   Pud *p;
+   Pud_Rect r;
+   unsigned int got[512], exp[512];
+   unsigned int i, n, overlaps, bit;
+   const uint8_t *occ;
+   int at;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(pud_units_index_build(p) != PUD_TRUE);
+
+   /* Rect and point queries give what a linear scan gives */
+   srand(42);
+   for (i = 0; i < 2000; i++)
+     {
+        r.x = (unsigned int)rand() % p->map_w;
+        r.y = (unsigned int)rand() % p->map_h;
+        r.w = 1 + (unsigned int)rand() % 24;
+        r.h = 1 + (unsigned int)rand() % 24;
+        n = pud_units_in_rect(p, &r, got, 512);
+        fail_if(n != _units_in_rect_naive(p, &r, exp));
+        fail_if(memcmp(got, exp, n * sizeof(unsigned int)) != 0);
+
+        r.w = 1;
+        r.h = 1;
+        n = _units_in_rect_naive(p, &r, exp);
+        at = pud_unit_at(p, r.x, r.y);
+        fail_if(at != ((n) ? (int)exp[n - 1] : -1));
+     }
+   r.x = 0;
+   r.y = 0;
+   r.w = p->map_w;
+   r.h = p->map_h;
+   fail_if(pud_units_in_rect(p, &r, NULL, 0) != p->units_count);
+
+   /* Truncated: the first units of pud->units are kept */
+   for (i = 1; i <= p->units_count; i += 13)
+     {
+        memset(got, 0xff, sizeof(got));
+        fail_if(pud_units_in_rect(p, &r, got, i) != p->units_count);
+        for (n = 0; n < i; n++)
+          fail_if(got[n] != n);
+        fail_if(got[i] != 0xffffffff);
+     }
+
+   /* Occupancy bitmap */
+   occ = pud_units_occupancy_get(p, &overlaps);
+   fail_if(occ == NULL);
+   r.w = 1;
+   r.h = 1;
+   for (r.y = 0; r.y < p->map_h; r.y++)
+     for (r.x = 0; r.x < p->map_w; r.x++)
+       {
+          bit = (r.y * p->map_w) + r.x;
+          n = _units_in_rect_naive(p, &r, exp);
+          fail_if(!!(occ[bit >> 3] & (1 << (bit & 7))) != !!n);
+          fail_if(pud_units_area_free_is(p, &r) != !n);
+       }
+
+   /* Added units are indexed */
+   r.x = 0;
+   r.y = 0;
+   r.w = 4;
+   r.h = 4;
+   while (!pud_units_area_free_is(p, &r)) r.x++;
+   fail_if(pud_unit_add(p, r.x, r.y, PUD_PLAYER_RED, PUD_UNIT_GREAT_HALL, 1) < 0);
+   fail_if(pud_units_area_free_is(p, &r) != PUD_FALSE);
+   fail_if(pud_unit_at(p, r.x + 3, r.y + 3) != (int)p->units_count - 1);
+   occ = pud_units_occupancy_get(p, &i);
+   fail_if(i != overlaps);
+
+   /* Out of the map */
+   r.x = p->map_w;
+   fail_if(pud_units_in_rect(p, &r, got, 512) != 0);
+   fail_if(pud_unit_at(p, p->map_w, 0) != -1);
+
+   /* Freed, then built again by the next query */
+   pud_units_index_free(p);
+   r.x = 0;
+   r.y = 0;
+   r.w = 1;
+   r.h = 1;
+   n = _units_in_rect_naive(p, &r, exp);
+   fail_if(pud_unit_at(p, 0, 0) != ((n) ? (int)exp[n - 1] : -1));
+   pud_close(p);
+}
+END_TEST
+
+START_TEST(units_bulk)
+{
+   Pud *p;
+   Pud_Unit_Data *units;
+   Pud_Rect r;
+   const unsigned int count = 5000;
+   unsigned int i, first, capacity, grows = 0;
+
+   p = tests_cibola_open(PUD_OPEN_MODE_RW);
+   fail_if(p == NULL);
+   fail_if(pud_units_index_build(p) != PUD_TRUE);
+   first = p->units_count;
+
+   units = malloc(count * sizeof(Pud_Unit_Data));
+   fail_if(units == NULL);
+   srand(7);
+   for (i = 0; i < count; i++)
+     {
+        units[i].x = (uint16_t)(rand() % p->map_w);
+        units[i].y = (uint16_t)(rand() % p->map_h);
+        units[i].type = PUD_UNIT_CRITTER_SHEEP;
+        units[i].owner = PUD_PLAYER_NEUTRAL;
+        units[i].alter = 0;
+     }
+
+   /* A single invalid unit: nothing is added */
+   units[count / 2].x = (uint16_t)p->map_w;
+   fail_if(pud_units_add_bulk(p, units, count) != -1);
+   fail_if(p->units_count != first);
+   units[count / 2].x = 0;
+   units[count / 3].type = 0xff;
+   fail_if(pud_units_add_bulk(p, units, count) != -1);
+   fail_if(p->units_count != first);
+   units[count / 3].type = PUD_UNIT_CRITTER_SHEEP;
+
+   fail_if(pud_units_add_bulk(p, units, count) != (int)(first + count));
+   fail_if(memcmp(&(p->units[first]), units, count * sizeof(Pud_Unit_Data)) != 0);
+   fail_if(pud_units_add_bulk(p, units, 0) != (int)(first + count));
+
+   /* Unit by unit, the storage grows geometrically */
+   capacity = p->units_capacity;
+   for (i = 0; i < count; i++)
+     {
+        fail_if(pud_unit_add(p, units[i].x, units[i].y, PUD_PLAYER_NEUTRAL,
+                             PUD_UNIT_CRITTER_SHEEP, 0) != (int)(first + count + i + 1));
+        if (p->units_capacity != capacity) grows++;
+        capacity = p->units_capacity;
+     }
+   fail_if(grows > 4);
+   fail_if(p->units_capacity < p->units_count);
+   fail_if(pud_unit_add(p, (uint16_t)p->map_w, 0, PUD_PLAYER_NEUTRAL,
+                        PUD_UNIT_CRITTER_SHEEP, 0) != -1);
+
+   /* The index followed */
+   r.x = 0;
+   r.y = 0;
+   r.w = p->map_w;
+   r.h = p->map_h;
+   fail_if(pud_units_in_rect(p, &r, NULL, 0) != p->units_count);
+
+   free(units);
+   pud_close(p);
+}
+END_TEST
+
+void
+test_units(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, units_index);
+   tcase_add_test(tc, units_bulk);
+}
@@ -1,8 +1,37 @@
 #include "tests.h"
 
+static void
+_setup(void)
+{
+   fail_if(pud_init() != PUD_TRUE);
+}
+
+static void
+_teardown(void)
+{
+   pud_shutdown();
+}
+
+void
+tests_fixture_add(TCase *tc)
+{
+   tcase_add_checked_fixture(tc, _setup, _teardown);
+}
+
+Pud *
+tests_cibola_open(Pud_Open_Mode mode)
+{
+   return pud_open(TESTS_CIBOLA, mode);
+}
+
 static const Efl_Test_Case etc[] = {
      { "Standalone", test_standalone },
      { "Open", test_open },
+     { "Save", test_save },
+     { "Batch", test_batch },
+     { "Minimap", test_minimap },
+     { "Units", test_units },
+     { "Tiles", test_tiles },
      { NULL, NULL }
 };
 
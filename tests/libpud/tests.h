@@ -2,8 +2,22 @@
 #define __TESTS_H__
 
 #include "../test_suite.h"
+#include <pud.h>
+
+#define TESTS_CIBOLA TESTS_SRC_DIR"/libpud/cibola.pud"
+
+/* Fixture of the test cases that use libpud: init and shutdown */
+void tests_fixture_add(TCase *tc);
+
+/* The reference map, as tests mutate and compare it */
+Pud *tests_cibola_open(Pud_Open_Mode mode);
 
 void test_standalone(TCase *tc);
 void test_open(TCase *tc);
+void test_save(TCase *tc);
+void test_batch(TCase *tc);
+void test_minimap(TCase *tc);
+void test_units(TCase *tc);
+void test_tiles(TCase *tc);
 
 #endif
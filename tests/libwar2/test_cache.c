@@ -0,0 +1,157 @@
+#include "tests.h"
+
+#define S TESTS_WAR_ENTRY_SIZE
+
+static Pud_Bool
+_entry_touch(War2_Data    *w2,
+             unsigned int  entry)
+{
+   War2_Entry *e;
+   Pud_Bool ok;
+
+   e = war2_entry_get(w2, entry);
+   if (!e) return PUD_FALSE;
+   ok = ((e->size == S) && (!memcmp(e->data, tests_war_expected(entry), S)));
+   war2_entry_unref(e);
+   return ok;
+}
+
+START_TEST(lru)
+{
+   War2_Data *w2;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+   fail_if(w2->cache_budget != WAR2_CACHE_BUDGET_DEFAULT);
+   war2_cache_budget_set(w2, 3 * S);
+
+   fail_if(!_entry_touch(w2, 0));
+   fail_if(!_entry_touch(w2, 1));
+   fail_if(!_entry_touch(w2, 2));
+   fail_if(w2->cache_size != 3 * S);
+
+   /* 1 is now the least recently used */
+   fail_if(!_entry_touch(w2, 0));
+   fail_if(!_entry_touch(w2, 3));
+   fail_if(w2->cache_size != 3 * S);
+   fail_if(w2->cache[1] != NULL);
+   fail_if((!w2->cache[0]) || (!w2->cache[2]) || (!w2->cache[3]));
+   fail_if(w2->lru_first != w2->cache[3]);
+   fail_if(w2->lru_last != w2->cache[2]);
+
+   war2_close(w2);
+}
+END_TEST
+
+START_TEST(budget)
+{
+   War2_Data *w2;
+   War2_Entry *e[4];
+   unsigned int i;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+   war2_cache_budget_set(w2, 2 * S);
+
+   /* Referenced entries stay, even over the budget */
+   for (i = 0; i < 4; i++)
+     {
+        e[i] = war2_entry_get(w2, i);
+        fail_if(e[i] == NULL);
+     }
+   fail_if(w2->cache_size != 4 * S);
+   for (i = 0; i < 4; i++)
+     war2_entry_unref(e[i]);
+   fail_if(w2->cache_size != 2 * S);
+   fail_if((!w2->cache[2]) || (!w2->cache[3]));
+
+   /* Lowering the budget evicts */
+   war2_cache_budget_set(w2, S);
+   fail_if(w2->cache_size != S);
+   fail_if(w2->cache[2] != NULL);
+
+   /* No budget: entries are not cached, the last reference frees them */
+   war2_cache_budget_set(w2, 0);
+   fail_if(w2->cache_size != 0);
+   e[0] = war2_entry_get(w2, 5);
+   fail_if(e[0] == NULL);
+   fail_if(e[0]->w2 != NULL);
+   fail_if(w2->cache[5] != NULL);
+   fail_if(memcmp(e[0]->data, tests_war_expected(5), S) != 0);
+   war2_entry_unref(e[0]);
+
+   /* Nor when larger than the budget */
+   war2_cache_budget_set(w2, S - 1);
+   fail_if(!_entry_touch(w2, 5));
+   fail_if(w2->cache_size != 0);
+
+   war2_close(w2);
+}
+END_TEST
+
+START_TEST(refs)
+{
+   War2_Data *w2;
+   War2_Entry *e, *f;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   e = war2_entry_get(w2, 7);
+   fail_if(e == NULL);
+   f = war2_entry_get(w2, 7);
+   fail_if(f != e);
+   fail_if(e->refs != 2);
+   war2_entry_unref(f);
+
+   /* References outlive the archive */
+   war2_close(w2);
+   fail_if(e->w2 != NULL);
+   fail_if(memcmp(e->data, tests_war_expected(7), S) != 0);
+   war2_entry_unref(e);
+}
+END_TEST
+
+START_TEST(extract)
+{
+   War2_Data *w2;
+   War2_Entry *e;
+   unsigned char *data;
+   size_t size;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   /* Missing entries are not cached by extractions */
+   data = war2_entry_extract(w2, 9, &size);
+   fail_if(data == NULL);
+   fail_if(size != S);
+   fail_if(memcmp(data, tests_war_expected(9), S) != 0);
+   free(data);
+   fail_if(w2->cache_size != 0);
+
+   /* Cached ones are copied */
+   e = war2_entry_get(w2, 9);
+   fail_if(e == NULL);
+   data = war2_entry_extract(w2, 9, &size);
+   fail_if(data == NULL);
+   fail_if(data == e->data);
+   fail_if(size != S);
+   fail_if(memcmp(data, e->data, S) != 0);
+   free(data);
+   fail_if(e->refs != 1);
+   war2_entry_unref(e);
+
+   war2_close(w2);
+}
+END_TEST
+
+void
+test_cache(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, lru);
+   tcase_add_test(tc, budget);
+   tcase_add_test(tc, refs);
+   tcase_add_test(tc, extract);
+}
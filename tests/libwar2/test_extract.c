@@ -0,0 +1,150 @@
+#include "tests.h"
+#include <unistd.h>
+
+#define S TESTS_WAR_ENTRY_SIZE
+
+typedef struct
+{
+   War2_Data    *w2;
+   unsigned int  first;
+   unsigned int  calls;
+   unsigned int  errors;
+   Pud_Bool      ordered;
+   unsigned char seen[TESTS_WAR_ENTRIES];
+   unsigned char altered[TESTS_WAR_ENTRIES];
+} Check;
+
+static Pud_Bool
+_altered_is(const War2_Extract_Result *res)
+{
+   size_t i;
+
+   for (i = 0; i < res->size; i++)
+     if (res->data[i] != 0xff) return PUD_FALSE;
+   return (res->size == S);
+}
+
+static void
+_check_cb(void                      *data,
+          const War2_Extract_Result *res)
+{
+   Check *const c = data;
+   unsigned int i;
+
+   if ((res->entry >= TESTS_WAR_ENTRIES) || (c->seen[res->entry]) ||
+       (!res->data))
+     {
+        c->errors++;
+        free(res->data);
+        return;
+     }
+   if ((c->ordered) && (res->entry != c->first + c->calls))
+     c->errors++;
+   c->altered[res->entry] = (c->w2) && (_altered_is(res));
+   if ((!c->altered[res->entry]) &&
+       ((res->size != S) || (memcmp(res->data, tests_war_expected(res->entry), S))))
+     c->errors++;
+
+   c->seen[res->entry] = 1;
+   c->calls++;
+   free(res->data);
+
+   /* Entries decoded from now on are only made of 0xff: stored ones are
+    * filled with it, and compressed ones become runs of literals. Without
+    * backpressure, the other workers would be done by then. */
+   if ((c->w2) && (res->entry == c->first))
+     {
+        usleep(50 * 1000);
+        for (i = c->first + 2; i < TESTS_WAR_ENTRIES - 1; i++)
+          memset(c->w2->entries[i] + 4, 0xff,
+                 c->w2->entries[i + 1] - c->w2->entries[i] - 4);
+     }
+}
+
+START_TEST(ordered)
+{
+   War2_Data *w2;
+   Check c;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   memset(&c, 0, sizeof(c));
+   c.ordered = PUD_TRUE;
+   c.first = 3;
+   fail_if(!war2_entries_extract(w2, 3, 40, 4, PUD_TRUE, 0, _check_cb, &c));
+   fail_if(c.calls != 40);
+   fail_if(c.errors != 0);
+
+   /* Whatever the order */
+   memset(&c, 0, sizeof(c));
+   fail_if(!war2_entries_extract_all(w2, 4, PUD_FALSE, _check_cb, &c));
+   fail_if(c.calls != TESTS_WAR_ENTRIES);
+   fail_if(c.errors != 0);
+
+   /* An entry larger than the memory must not block */
+   memset(&c, 0, sizeof(c));
+   c.ordered = PUD_TRUE;
+   fail_if(!war2_entries_extract(w2, 0, TESTS_WAR_ENTRIES, 4, PUD_TRUE, S / 2,
+                                 _check_cb, &c));
+   fail_if(c.calls != TESTS_WAR_ENTRIES);
+   fail_if(c.errors != 0);
+
+   /* Invalid ranges */
+   fail_if(war2_entries_extract(w2, 40, 9, 4, PUD_TRUE, 0, _check_cb, &c));
+   fail_if(war2_entries_extract(w2, TESTS_WAR_ENTRIES + 1, 0, 4, PUD_TRUE, 0,
+                                _check_cb, &c));
+   fail_if(!war2_entries_extract(w2, TESTS_WAR_ENTRIES, 0, 4, PUD_TRUE, 0,
+                                 _check_cb, &c));
+   fail_if(c.calls != TESTS_WAR_ENTRIES);
+
+   war2_close(w2);
+}
+END_TEST
+
+START_TEST(mem_max)
+{
+   War2_Data *w2;
+   unsigned char *map, *copy;
+   unsigned int i;
+   Check c;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   /* Work on a writable copy of the archive, so that the callback can
+    * alter the entries that were not decoded yet */
+   map = w2->mem_map;
+   copy = malloc(w2->mem_map_size);
+   fail_if(copy == NULL);
+   memcpy(copy, map, w2->mem_map_size);
+   for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+     w2->entries[i] = copy + (w2->entries[i] - map);
+   w2->mem_map = copy;
+
+   /* The first two entries take all the memory: no other entry can be
+    * decoded before the first one has been delivered */
+   memset(&c, 0, sizeof(c));
+   c.w2 = w2;
+   c.ordered = PUD_TRUE;
+   fail_if(!war2_entries_extract(w2, 0, 16, 8, PUD_TRUE, 2 * S,
+                                 _check_cb, &c));
+   fail_if(c.calls != 16);
+   fail_if(c.errors != 0);
+   fail_if((c.altered[0]) || (c.altered[1]));
+   for (i = 2; i < 16; i++)
+     fail_if(!c.altered[i]);
+
+   w2->mem_map = map;
+   free(copy);
+   war2_close(w2);
+}
+END_TEST
+
+void
+test_extract(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, ordered);
+   tcase_add_test(tc, mem_max);
+}
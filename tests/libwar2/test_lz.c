@@ -0,0 +1,74 @@
+#include "tests.h"
+
+START_TEST(lz)
+{
+   War2_Data *w2;
+   unsigned char *data;
+   unsigned int i;
+   size_t size;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+   fail_if(w2->entries_count != TESTS_WAR_ENTRIES);
+
+   for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+     {
+        data = war2_entry_extract(w2, i, &size);
+        fail_if(data == NULL);
+        fail_if(size != TESTS_WAR_ENTRY_SIZE);
+        fail_if(memcmp(data, tests_war_expected(i), size) != 0);
+        free(data);
+     }
+
+   war2_close(w2);
+}
+END_TEST
+
+START_TEST(errors)
+{
+   War2_Data *w2;
+   War2_Entry *e;
+   unsigned char *data;
+   Pud_Bool owned;
+   size_t size;
+
+   fail_if(war2_open(TESTS_BUILD_DIR"/nonexistent.war", 0) != NULL);
+
+   /* Out of range */
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+   size = 1;
+   fail_if(war2_entry_extract(w2, TESTS_WAR_ENTRIES, &size) != NULL);
+   fail_if(size != 0);
+   fail_if(war2_entry_get(w2, TESTS_WAR_ENTRIES) != NULL);
+   fail_if(war2_entry_view(w2, TESTS_WAR_ENTRIES, &size, &owned) != NULL);
+   fail_if(owned);
+   war2_close(w2);
+
+   /* The last stream misses a byte: only its entry fails */
+   w2 = tests_war_open(TESTS_WAR_TRUNCATED);
+   fail_if(w2 == NULL);
+   size = 1;
+   fail_if(war2_entry_extract(w2, TESTS_WAR_ENTRIES - 1, &size) != NULL);
+   fail_if(size != 0);
+   fail_if(war2_entry_get(w2, TESTS_WAR_ENTRIES - 1) != NULL);
+
+   e = war2_entry_get(w2, TESTS_WAR_ENTRIES - 3);
+   fail_if(e == NULL);
+   fail_if(memcmp(e->data, tests_war_expected(TESTS_WAR_ENTRIES - 3), e->size) != 0);
+   war2_entry_unref(e);
+   data = war2_entry_extract(w2, TESTS_WAR_ENTRIES - 2, &size);
+   fail_if(data == NULL);
+   fail_if(size != TESTS_WAR_ENTRY_SIZE);
+   free(data);
+   war2_close(w2);
+}
+END_TEST
+
+void
+test_lz(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, lz);
+   tcase_add_test(tc, errors);
+}
@@ -0,0 +1,87 @@
+#include "tests.h"
+
+#define THREADS 8
+#define ROUNDS  4
+
+typedef struct
+{
+   War2_Data    *w2;
+   unsigned int  id;
+   unsigned int  errors;
+} Thread;
+
+static void *
+_thread_run(void *data)
+{
+   Thread *const t = data;
+   War2_Entry *e;
+   unsigned char *ptr;
+   unsigned int i, r, entry;
+   size_t size;
+
+   /* Each thread walks the entries from a different place, extracting
+    * copies and taking references in turns */
+   for (r = 0; r < ROUNDS; r++)
+     {
+        for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+          {
+             entry = (i + t->id * 7) % TESTS_WAR_ENTRIES;
+             if ((i + r) & 1)
+               {
+                  ptr = war2_entry_extract(t->w2, entry, &size);
+                  if ((!ptr) || (size != TESTS_WAR_ENTRY_SIZE) ||
+                      (memcmp(ptr, tests_war_expected(entry), size)))
+                    t->errors++;
+                  free(ptr);
+               }
+             else
+               {
+                  e = war2_entry_get(t->w2, entry);
+                  if ((!e) || (e->size != TESTS_WAR_ENTRY_SIZE) ||
+                      (memcmp(e->data, tests_war_expected(entry), e->size)))
+                    t->errors++;
+                  war2_entry_unref(e);
+               }
+          }
+     }
+
+   return NULL;
+}
+
+START_TEST(concurrent)
+{
+   War2_Data *w2;
+   Thread t[THREADS];
+   pthread_t th[THREADS];
+   unsigned int i;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   /* A small cache: entries are evicted while others use them */
+   war2_cache_budget_set(w2, 4 * TESTS_WAR_ENTRY_SIZE);
+
+   for (i = 0; i < THREADS; i++)
+     {
+        t[i].w2 = w2;
+        t[i].id = i;
+        t[i].errors = 0;
+        fail_if(pthread_create(&(th[i]), NULL, _thread_run, &(t[i])) != 0);
+     }
+   for (i = 0; i < THREADS; i++)
+     {
+        pthread_join(th[i], NULL);
+        fail_if(t[i].errors != 0);
+     }
+   fail_if(w2->cache_size > 4 * TESTS_WAR_ENTRY_SIZE);
+
+   war2_close(w2);
+}
+END_TEST
+
+void
+test_threads(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, concurrent);
+}
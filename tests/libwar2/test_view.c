@@ -0,0 +1,52 @@
+#include "tests.h"
+
+START_TEST(view)
+{
+   War2_Data *w2;
+   const unsigned char *p;
+   Pud_Bool owned;
+   size_t size;
+
+   w2 = tests_war_open(TESTS_WAR);
+   fail_if(w2 == NULL);
+
+   /* Stored: borrowed from the mapping */
+   p = war2_entry_view(w2, 4, &size, &owned);
+   fail_if(p == NULL);
+   fail_if(owned);
+   fail_if(size != TESTS_WAR_ENTRY_SIZE);
+   fail_if((p < w2->mem_map) || (p + size > w2->mem_map + w2->mem_map_size));
+   fail_if(memcmp(p, tests_war_expected(4), size) != 0);
+
+   /* Compressed: decoded, and owned by the caller */
+   p = war2_entry_view(w2, 5, &size, &owned);
+   fail_if(p == NULL);
+   fail_if(!owned);
+   fail_if(size != TESTS_WAR_ENTRY_SIZE);
+   fail_if(memcmp(p, tests_war_expected(5), size) != 0);
+   free((unsigned char *)p);
+
+   /* Failures */
+   owned = PUD_TRUE;
+   fail_if(war2_entry_view(w2, TESTS_WAR_ENTRIES, &size, &owned) != NULL);
+   fail_if(owned);
+   fail_if(size != 0);
+   fail_if(war2_entry_view(w2, 4, &size, NULL) != NULL);
+   fail_if(war2_entry_view(NULL, 4, &size, &owned) != NULL);
+   war2_close(w2);
+
+   w2 = tests_war_open(TESTS_WAR_TRUNCATED);
+   fail_if(w2 == NULL);
+   owned = PUD_TRUE;
+   fail_if(war2_entry_view(w2, TESTS_WAR_ENTRIES - 1, &size, &owned) != NULL);
+   fail_if(owned);
+   war2_close(w2);
+}
+END_TEST
+
+void
+test_view(TCase *tc)
+{
+   tests_fixture_add(tc);
+   tcase_add_test(tc, view);
+}
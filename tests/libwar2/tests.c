@@ -0,0 +1,185 @@
+#include "tests.h"
+#include <unistd.h>
+
+static unsigned char _expected[TESTS_WAR_ENTRIES][TESTS_WAR_ENTRY_SIZE];
+
+/* Worst case of input of a compressed entry: all literals */
+#define STREAM_MAX (TESTS_WAR_ENTRY_SIZE + (TESTS_WAR_ENTRY_SIZE / 8) + 4)
+
+static uint32_t
+_random(uint32_t *state)
+{
+   /* xorshift32 */
+   *state ^= *state << 13;
+   *state ^= *state >> 17;
+   *state ^= *state << 5;
+   return *state;
+}
+
+/*
+ * The byte-per-byte decoder of wargus, which the one of libwar2 must
+ * match. It returns the number of bytes read, 0 if 'in' is too short.
+ */
+static size_t
+_lz_ref_decode(const unsigned char *in,
+               size_t               in_size,
+               unsigned char       *out,
+               size_t               ulen)
+{
+   const unsigned char *const start = in, *const in_end = in + in_size;
+   unsigned char buf[4096];
+   unsigned char *p = out, *const e = out + ulen;
+   unsigned int i, j, bi = 0;
+   uint16_t w;
+   uint8_t bits, b;
+
+   memset(buf, 0, sizeof(buf));
+   while (p < e)
+     {
+        if (in >= in_end) return 0;
+        bits = *(in++);
+        for (i = 0; i < 8; i++)
+          {
+             if (bits & 1)
+               {
+                  if (in >= in_end) return 0;
+                  b = *(in++);
+                  *(p++) = b;
+                  buf[bi++ & 0xfff] = b;
+               }
+             else
+               {
+                  if (in + 1 >= in_end) return 0;
+                  w = in[0] | (in[1] << 8);
+                  in += 2;
+                  j = (w >> 12) + 3;
+                  w &= 0x0fff;
+                  while (j--)
+                    {
+                       buf[bi++ & 0xfff] = *(p++) = buf[w++ & 0xfff];
+                       if (p == e) break;
+                    }
+               }
+             if (p == e) break;
+             bits >>= 1;
+          }
+     }
+
+   return in - start;
+}
+
+static Pud_Bool
+_war_write(const char *file,
+           Pud_Bool    truncated)
+{
+   static unsigned char streams[TESTS_WAR_ENTRIES][STREAM_MAX];
+   size_t len[TESTS_WAR_ENTRIES];
+   uint32_t offsets[TESTS_WAR_ENTRIES], hdr, magic = 0x19, state;
+   uint16_t count = TESTS_WAR_ENTRIES, fid = 0;
+   unsigned int i, k;
+   size_t off;
+   FILE *f;
+
+   /* Any stream is valid: compressed entries are random streams, and the
+    * reference decoder tells what they hold */
+   for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+     {
+        state = 0x9e3779b9 * (i + 1);
+        for (k = 0; k < STREAM_MAX; k++)
+          streams[i][k] = _random(&state) & 0xff;
+
+        if (i & 1)
+          {
+             len[i] = _lz_ref_decode(streams[i], STREAM_MAX, _expected[i],
+                                     TESTS_WAR_ENTRY_SIZE);
+             if (len[i] == 0) return PUD_FALSE;
+             if (i != TESTS_WAR_ENTRIES - 1) len[i] = STREAM_MAX;
+             else if (truncated) len[i]--;
+          }
+        else
+          {
+             memcpy(_expected[i], streams[i], TESTS_WAR_ENTRY_SIZE);
+             len[i] = TESTS_WAR_ENTRY_SIZE;
+          }
+     }
+
+   off = 8 + sizeof(offsets);
+   for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+     {
+        offsets[i] = off;
+        off += 4 + len[i];
+     }
+
+   f = fopen(file, "wb");
+   if (!f) return PUD_FALSE;
+   fwrite(&magic, sizeof(magic), 1, f);
+   fwrite(&count, sizeof(count), 1, f);
+   fwrite(&fid, sizeof(fid), 1, f);
+   fwrite(offsets, sizeof(offsets), 1, f);
+   for (i = 0; i < TESTS_WAR_ENTRIES; i++)
+     {
+        hdr = TESTS_WAR_ENTRY_SIZE | ((i & 1) ? 0x20 << 24 : 0);
+        fwrite(&hdr, sizeof(hdr), 1, f);
+        fwrite(streams[i], len[i], 1, f);
+     }
+
+   return (fclose(f) == 0);
+}
+
+static void
+_setup(void)
+{
+   fail_if(war2_init() != PUD_TRUE);
+   fail_if(!_war_write(TESTS_WAR_TRUNCATED, PUD_TRUE));
+   fail_if(!_war_write(TESTS_WAR, PUD_FALSE));
+}
+
+static void
+_teardown(void)
+{
+   unlink(TESTS_WAR);
+   unlink(TESTS_WAR_TRUNCATED);
+   war2_shutdown();
+}
+
+void
+tests_fixture_add(TCase *tc)
+{
+   tcase_add_checked_fixture(tc, _setup, _teardown);
+}
+
+War2_Data *
+tests_war_open(const char *file)
+{
+   return war2_open(file, 0);
+}
+
+const unsigned char *
+tests_war_expected(unsigned int entry)
+{
+   return _expected[entry];
+}
+
+static const Efl_Test_Case etc[] = {
+     { "LZ", test_lz },
+     { "Cache", test_cache },
+     { "Threads", test_threads },
+     { "Extract", test_extract },
+     { "View", test_view },
+     { NULL, NULL }
+};
+
+int
+main(int          argc,
+     const char **argv)
+{
+   int failed_count;
+
+   if (!_efl_test_option_disp(argc, argv, etc))
+     return 0;
+
+   failed_count = _efl_suite_build_and_run(argc - 1, argv + 1,
+                                           "libwar2", etc);
+
+   return (failed_count == 0) ? 0 : -1;
+}
@@ -0,0 +1,26 @@
+#ifndef _TESTS_H_
+#define _TESTS_H_
+
+#include "../test_suite.h"
+#include <war2.h>
+
+/* Synthetic archives, written by the fixture. Even entries are stored,
+ * odd ones are compressed. The last entry is compressed and its stream
+ * ends exactly at the end of the file (one byte short when truncated). */
+#define TESTS_WAR           TESTS_BUILD_DIR"/libwar2.war"
+#define TESTS_WAR_TRUNCATED TESTS_BUILD_DIR"/libwar2_truncated.war"
+
+#define TESTS_WAR_ENTRIES    48
+#define TESTS_WAR_ENTRY_SIZE 4096
+
+void tests_fixture_add(TCase *tc);
+War2_Data *tests_war_open(const char *file);
+const unsigned char *tests_war_expected(unsigned int entry);
+
+void test_lz(TCase *tc);
+void test_cache(TCase *tc);
+void test_threads(TCase *tc);
+void test_extract(TCase *tc);
+void test_view(TCase *tc);
+
+#endif /* ! _TESTS_H_ */
@@ -9,10 +9,13 @@
 #include "ppm.h"
 #include "../include/debug.h"
 
+/* Must match PUD_TILES_COUNT in include/pud_private.h */
+#define TILES_COUNT 0x0a00
+
 static void
 _usage(void)
 {
-   fprintf(stderr, "*** Usage: tilemap <file.ppm> <map.txt>\n");
+   fprintf(stderr, "*** Usage: tilemap <era> <file.ppm> <map.txt>\n");
    fprintf(stderr,
            "*** Map file format (x,y,tile):\n"
            "%%i %%i 0x%%04x\\n\n");
@@ -24,37 +27,66 @@ main(int    argc,
 {
    Col *ppm;
    Col c;
+   Col palette[256];
+   uint8_t tiles[TILES_COUNT];
+   unsigned int count = 1; /* Entry 0 is the unknown color */
+   unsigned int k;
    int w, h;
    FILE *f;
    int x, y, tile;
+   const char *era;
 
    /* Getopt */
-   if (argc != 3)
+   if (argc != 4)
      {
         _usage();
         return 1;
      }
+   era = argv[1];
 
-   ppm = ppm_parse(argv[1], &w, &h);
-   if (!ppm) DIE_RETURN(1, "Failed to parse [%s]", argv[1]);
+   ppm = ppm_parse(argv[2], &w, &h);
+   if (!ppm) DIE_RETURN(1, "Failed to parse [%s]", argv[2]);
 
-   f = fopen(argv[2], "r");
-   if (!f) DIE_RETURN(1, "Failed to open [%s]", argv[2]);
+   f = fopen(argv[3], "r");
+   if (!f)
+     {
+        free(ppm);
+        DIE_RETURN(1, "Failed to open [%s]", argv[3]);
+     }
 
+   memset(tiles, 0, sizeof(tiles));
    while ((!feof(f)) && (!ferror(f)))
      {
-        fscanf(f, "%i %i %x\n", &x, &y, &tile);
+        if (fscanf(f, "%i %i %x\n", &x, &y, &tile) != 3)
+          break;
+        if ((x < 0) || (x >= w) || (y < 0) || (y >= h) ||
+            (tile < 0) || (tile >= TILES_COUNT))
+          {
+             ERR("Invalid entry %i %i 0x%04x", x, y, tile);
+             continue;
+          }
         c = ppm[x + (y * w)];
 
         /* Ignore black (nonexistant tile) */
         if ((c.r == 0) && (c.g == 0) && (c.b == 0))
           continue;
 
-        printf("case 0x%04x: return color_make(0x%02x, 0x%02x, 0x%02x);\n",
-               tile, c.r, c.g, c.b);
+        for (k = 1; k < count; k++)
+          if (!memcmp(&palette[k], &c, sizeof(c)))
+            break;
+        if (k == count)
+          {
+             if (count == 256)
+               {
+                  fclose(f);
+                  free(ppm);
+                  DIE_RETURN(2, "Too many colors");
+               }
+             palette[count++] = c;
+          }
+        tiles[tile] = k;
      }
 
-
    if (ferror(f))
      {
         fclose(f);
@@ -62,9 +94,24 @@ main(int    argc,
         DIE_RETURN(2, "Ferror()");
      }
 
-
    fclose(f);
    free(ppm);
 
+   printf("static const Pud_Color _%s_palette[] =\n{\n", era);
+   printf("   UNKNOWN_COLOR,\n");
+   for (k = 1; k < count; k++)
+     printf("   { 0x%02x, 0x%02x, 0x%02x, 0xff },\n",
+            palette[k].r, palette[k].g, palette[k].b);
+   printf("};\n\n");
+
+   printf("static const uint8_t _%s_tiles[PUD_TILES_TABLE_SIZE] =\n{\n", era);
+   for (k = 0; k < TILES_COUNT; k++)
+     {
+        if (k % 16 == 0) printf("  ");
+        printf(" %2u,", tiles[k]);
+        if (k % 16 == 15) printf("\n");
+     }
+   printf("};\n");
+
    return 0;
 }
@@ -0,0 +1,226 @@
+/*
+ * war2_lz_bench.c
+ * war2_lz_bench
+ *
+ * Copyright (c) 2016 Jean Guyomarc'h
+ */
+
+#include "../include/war2_private.h"
+
+/*
+ * Compares war2_lz_decode() with the byte-per-byte decoder it replaced:
+ * outputs must be identical, and both are timed. Without a .war file,
+ * random streams are decoded (any stream is valid).
+ */
+
+#define SYNTH_STREAMS 64
+#define SYNTH_SIZE    (256 * 1024)
+#define ROUNDS        10
+
+/* As war2_mem_map_ok(): a call per byte read */
+static __attribute__((noinline)) Pud_Bool
+_ref_in_ok(const unsigned char *p,
+           const unsigned char *end)
+{
+   return (p < end);
+}
+
+static Pud_Bool
+_ref_decode(const unsigned char *in,
+            size_t               in_size,
+            unsigned char       *out,
+            size_t               ulen)
+{
+   const unsigned char *const in_end = in + in_size;
+   unsigned char buf[4096];
+   unsigned char *p = out, *const e = out + ulen;
+   unsigned int i, j, bi = 0;
+   uint16_t w;
+   uint8_t bits, b;
+
+   memset(buf, 0, sizeof(buf));
+   while (p < e)
+     {
+        if (!_ref_in_ok(in, in_end)) return PUD_FALSE;
+        bits = *(in++);
+        for (i = 0; i < 8; i++)
+          {
+             if (bits & 1)
+               {
+                  if (!_ref_in_ok(in, in_end)) return PUD_FALSE;
+                  b = *(in++);
+                  *(p++) = b;
+                  buf[bi++ & 0xfff] = b;
+               }
+             else
+               {
+                  if (!_ref_in_ok(in + 1, in_end)) return PUD_FALSE;
+                  w = in[0] | (in[1] << 8);
+                  in += 2;
+                  j = (w >> 12) + 3;
+                  w &= 0x0fff;
+                  while (j--)
+                    {
+                       buf[bi++ & 0xfff] = *(p++) = buf[w++ & 0xfff];
+                       if (p == e) break;
+                    }
+               }
+             if (p == e) break;
+             bits >>= 1;
+          }
+     }
+
+   return PUD_TRUE;
+}
+
+typedef struct
+{
+   const unsigned char *in;
+   size_t               in_size;
+   size_t               ulen;
+} Stream;
+
+static double
+_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+static int
+_bench(const Stream *streams,
+       unsigned int  count)
+{
+   Pud_Bool (*const decoders[2])(const unsigned char *, size_t, unsigned char *, size_t) = {
+      _ref_decode, war2_lz_decode
+   };
+   const char *const names[2] = { "byte per byte", "war2_lz_decode" };
+   unsigned char *out[2];
+   size_t max = 0, total = 0;
+   unsigned int i, k, r;
+   double t0, t[2] = { 0.0, 0.0 };
+
+   for (i = 0; i < count; i++)
+     {
+        if (streams[i].ulen > max) max = streams[i].ulen;
+        total += streams[i].ulen;
+     }
+   out[0] = malloc(max + 1);
+   out[1] = malloc(max + 1);
+   if ((!out[0]) || (!out[1])) DIE_RETURN(1, "Failed to allocate memory");
+
+   for (i = 0; i < count; i++)
+     {
+        for (k = 0; k < 2; k++)
+          {
+             t0 = _now();
+             for (r = 0; r < ROUNDS; r++)
+               decoders[k](streams[i].in, streams[i].in_size, out[k], streams[i].ulen);
+             t[k] += _now() - t0;
+          }
+        if (memcmp(out[0], out[1], streams[i].ulen))
+          {
+             free(out[0]);
+             free(out[1]);
+             DIE_RETURN(2, "Stream %u: outputs differ", i);
+          }
+     }
+
+   for (k = 0; k < 2; k++)
+     printf("%-16s %8.2f ms %8.1f MB/s\n", names[k], t[k] * 1000.0 / ROUNDS,
+            (total * ROUNDS) / (t[k] * 1e6));
+   printf("Speedup: %.2fx (%u streams, %zu bytes)\n", t[0] / t[1], count, total);
+
+   free(out[0]);
+   free(out[1]);
+   return 0;
+}
+
+static int
+_bench_synthetic(void)
+{
+   Stream streams[SYNTH_STREAMS];
+   unsigned char *data;
+   const size_t in_size = SYNTH_SIZE + (SYNTH_SIZE / 8) + 16;
+   unsigned int i;
+   size_t k;
+   int ret;
+
+   data = malloc(SYNTH_STREAMS * in_size);
+   if (!data) DIE_RETURN(1, "Failed to allocate memory");
+
+   /* Flag bytes are mostly literals (3 bits out of 4), and matches
+    * mostly long */
+   srand(42);
+   for (i = 0; i < SYNTH_STREAMS; i++)
+     {
+        for (k = 0; k < in_size; k++)
+          data[(i * in_size) + k] = (unsigned char)(rand() | rand());
+        streams[i].in = data + (i * in_size);
+        streams[i].in_size = in_size;
+        streams[i].ulen = SYNTH_SIZE;
+     }
+
+   ret = _bench(streams, SYNTH_STREAMS);
+   free(data);
+   return ret;
+}
+
+static int
+_bench_file(const char *file)
+{
+   War2_Data *w2;
+   Stream *streams;
+   unsigned int i, count = 0;
+   uint32_t l;
+   int ret;
+
+   w2 = war2_open(file, 0);
+   if (!w2) DIE_RETURN(1, "Failed to open [%s]", file);
+   streams = calloc(w2->entries_count, sizeof(Stream));
+   if (!streams)
+     {
+        war2_close(w2);
+        DIE_RETURN(1, "Failed to allocate memory");
+     }
+
+   /* Only compressed entries */
+   for (i = 0; i < w2->entries_count; i++)
+     {
+        if ((!w2->entries[i]) ||
+            (w2->entries[i] + 4 > w2->mem_map + w2->mem_map_size))
+          continue;
+        memcpy(&l, w2->entries[i], sizeof(l));
+        if ((l >> 24) != 0x20) continue;
+        streams[count].in = w2->entries[i] + 4;
+        streams[count].in_size = (w2->mem_map + w2->mem_map_size) - streams[count].in;
+        streams[count].ulen = l & 0x00ffffff;
+        count++;
+     }
+
+   ret = _bench(streams, count);
+   free(streams);
+   war2_close(w2);
+   return ret;
+}
+
+int
+main(int    argc,
+     char **argv)
+{
+   int ret;
+
+   if (argc > 2)
+     {
+        fprintf(stderr, "*** Usage: war2_lz_bench [file.war]\n");
+        return 1;
+     }
+
+   if (!war2_init()) DIE_RETURN(1, "Failed to init libwar2");
+   ret = (argc == 2) ? _bench_file(argv[1]) : _bench_synthetic();
+   war2_shutdown();
+
+   return ret;
+}